@@ -13,8 +13,9 @@ EEPROMService eepromService(preferences);
 OtaUpdaterService otaService;
 PowerManagerService powerManagerService;
 
+MetricsEventBus metricsEventBus;
 FlywheelService flywheelService;
-StrokeService strokeService;
+StrokeService strokeService(metricsEventBus);
 
 SdCardService sdCardService;
 BatteryBleService batteryBleService;
@@ -34,6 +35,7 @@ PowerManagerController powerManagerController(powerManagerService);
 void IRAM_ATTR rotationInterrupt()
 {
     flywheelService.processRotation(micros());
+    strokeController.notifyImpulseFromISR();
 }
 
 void attachRotationInterrupt()
@@ -36,6 +36,7 @@ extern OtaUpdaterService otaService;
 extern PowerManagerService powerManagerService;
 extern PowerManagerController powerManagerController;
 
+extern MetricsEventBus metricsEventBus;
 extern FlywheelService flywheelService;
 extern StrokeService strokeService;
 extern StrokeController strokeController;
@@ -9,6 +9,65 @@
 
 #include "./test.array.h"
 
+static unsigned char deltaTimeSubscriberId = 0;
+static unsigned char metricsSubscriberId = 0;
+static unsigned char logSubscriberId = 0;
+
+void onImpulseProcessed(const RowingDataModels::MetricsEvent &event)
+{
+    peripheralController.updateDeltaTime(event.deltaTime);
+}
+
+void onMetricsPublished(const RowingDataModels::MetricsEvent & /*event*/)
+{
+    // The event may have been emitted after the loop acquired the metrics, acquiring again makes sure they are at least as new as the event
+    strokeController.acquireData();
+    peripheralController.updateData(strokeController.getAllData());
+    lastUpdateTime = millis();
+
+    if constexpr (Configurations::enableEngineDiagnostics)
+    {
+        peripheralController.updateEngineDiagnostics(strokeController.getDiagnostics());
+    }
+}
+
+void logMetricsEvent(const RowingDataModels::MetricsEvent &event)
+{
+    strokeController.acquireData();
+    switch (event.type)
+    {
+    case MetricsEventType::ImpulseProcessed:
+        Log.traceln("deltaTime: %u", event.deltaTime);
+        break;
+    case MetricsEventType::DriveStarted:
+        // The recovery that ended with this drive is only known from here on, the stroke completed event comes a full drive later
+        Log.verboseln("drive started, recoveryDuration: %D", strokeController.getRecoveryDuration());
+        break;
+    case MetricsEventType::StrokeCompleted:
+        Log.traceln("driveDuration: %D", strokeController.getDriveDuration());
+        Log.traceln("recoveryDuration: %D", strokeController.getRecoveryDuration());
+        Log.traceln("dragFactor: %d", strokeController.getDragFactor());
+        Log.traceln("power: %d", strokeController.getAvgStrokePower());
+        Log.traceln("distance: %D", strokeController.getDistance() / 100.0);
+        Log.traceln("maxQueueDepth: %d, maxImpulseLag: %u", strokeController.getMaxQueueDepth(), strokeController.getMaxImpulseLag());
+        Log.traceln("maxEventBacklog: deltaTimes %d, metrics %d, log %d", metricsEventBus.getMaxBacklog(deltaTimeSubscriberId), metricsEventBus.getMaxBacklog(metricsSubscriberId), metricsEventBus.getMaxBacklog(logSubscriberId));
+        if constexpr (Configurations::enableEngineDiagnostics)
+        {
+            const auto diagnostics = strokeController.getDiagnostics();
+            Log.traceln("engine overruns: %u, max processing time: %u", diagnostics.getOverrunCount(), diagnostics.getHistogram(EngineStage::Total).getMaxTime());
+        }
+        break;
+    case MetricsEventType::DragFactorUpdated:
+        Log.verboseln("new dragFactor: %d", strokeController.getDragFactor());
+        break;
+    case MetricsEventType::SessionStopped:
+        Log.infoln("Rowing stopped, distance: %D", strokeController.getDistance() / 100.0);
+        break;
+    default:
+        break;
+    }
+}
+
 void setup()
 {
     Serial.begin(std::to_underlying(Configurations::baudRate));
@@ -27,6 +86,10 @@ void setup()
 
     peripheralController.begin();
     powerManagerController.begin();
+
+    deltaTimeSubscriberId = metricsEventBus.subscribe(onImpulseProcessed, {MetricsEventType::ImpulseProcessed});
+    metricsSubscriberId = metricsEventBus.subscribe(onMetricsPublished, {MetricsEventType::StrokeCompleted, MetricsEventType::SessionStopped});
+    logSubscriberId = metricsEventBus.subscribe(logMetricsEvent, {MetricsEventType::ImpulseProcessed, MetricsEventType::DriveStarted, MetricsEventType::StrokeCompleted, MetricsEventType::DragFactorUpdated, MetricsEventType::SessionStopped});
     strokeController.begin();
 
     if constexpr (Configurations::batteryPinNumber != GPIO_NUM_NC)
@@ -62,31 +125,17 @@ void loop()
     peripheralController.update(powerManagerController.getBatteryLevel());
     powerManagerController.update(strokeController.getLastImpulseTime(), peripheralController.isAnyDeviceConnected());
 
-    if (strokeController.getRawImpulseCount() != strokeController.getPreviousRawImpulseCount())
-    {
-        peripheralController.updateDeltaTime(strokeController.getDeltaTime());
-        strokeController.setPreviousRawImpulseCount();
-    }
+    // Subscribers only run for the events the stroke engine emitted since the last loop
+    metricsEventBus.dispatchAll();
 
     const auto now = millis();
     const auto minUpdateInterval = 4'000;
-    if (strokeController.getStrokeCount() != strokeController.getPreviousStrokeCount() || now - lastUpdateTime > minUpdateInterval)
+    if (now - lastUpdateTime > minUpdateInterval)
     {
         peripheralController.updateData(strokeController.getAllData());
         lastUpdateTime = now;
     }
 
-    if (strokeController.getStrokeCount() != strokeController.getPreviousStrokeCount())
-    {
-        Log.traceln("driveDuration: %D", strokeController.getDriveDuration());
-        Log.traceln("recoveryDuration: %D", strokeController.getRecoveryDuration());
-        Log.traceln("dragFactor: %d", strokeController.getDragFactor());
-        Log.traceln("power: %d", strokeController.getAvgStrokePower());
-        Log.traceln("distance: %D", strokeController.getDistance() / 100.0);
-
-        strokeController.setPreviousStrokeCount();
-    }
-
     if constexpr (Configurations::batteryPinNumber != GPIO_NUM_NC)
     {
         if (powerManagerController.getBatteryLevel() != powerManagerController.getPreviousBatteryLevel())
@@ -1,3 +1,4 @@
+#include <array>
 #include <numeric>
 #include <vector>
 
@@ -5,6 +6,7 @@
 #include "NimBLEDevice.h"
 
 #include "../../../utils/enums.h"
+#include "../ble-metrics.model.h"
 #include "./extended-metrics.service.h"
 
 using std::vector;
@@ -26,6 +28,11 @@ NimBLEService *ExtendedMetricBleService::setup(NimBLEServer *const server)
     extendedMetricsParams.characteristic = extendedMetricsService->createCharacteristic(CommonBleFlags::extendedMetricsUuid, NIMBLE_PROPERTY::NOTIFY);
     extendedMetricsParams.characteristic->setCallbacks(&extendedMetricsParams.callbacks);
 
+    if constexpr (Configurations::enableEngineDiagnostics)
+    {
+        engineDiagnosticsCharacteristic = extendedMetricsService->createCharacteristic(CommonBleFlags::engineDiagnosticsUuid, NIMBLE_PROPERTY::READ);
+    }
+
     return extendedMetricsService;
 }
 
@@ -57,4 +64,34 @@ unsigned short ExtendedMetricBleService::calculateMtu(const std::vector<unsigned
                     }
 
                     return std::min(previousMtu, currentMTU); });
-}
\ No newline at end of file
+}
+
+void ExtendedMetricBleService::setEngineDiagnostics(const EngineDiagnostics &diagnostics)
+{
+    ASSERT_SETUP_CALLED(engineDiagnosticsCharacteristic);
+
+    // Little endian uint32 values: the overrun count followed by the max time and the buckets of each stage histogram (in EngineStage order)
+    const auto valueCount = 1U + EngineDiagnostics::stageCount * (1U + EngineDiagnostics::bucketCount);
+    std::array<unsigned char, valueCount * sizeof(unsigned int)> temp{};
+    auto offset = 0U;
+    const auto write = [&temp, &offset](const unsigned long value)
+    {
+        temp[offset++] = static_cast<unsigned char>(value);
+        temp[offset++] = static_cast<unsigned char>(value >> 8);
+        temp[offset++] = static_cast<unsigned char>(value >> 16);
+        temp[offset++] = static_cast<unsigned char>(value >> 24);
+    };
+
+    write(diagnostics.getOverrunCount());
+    for (unsigned char stage = 0; stage < EngineDiagnostics::stageCount; ++stage)
+    {
+        const auto &histogram = diagnostics.getHistogram(static_cast<EngineStage>(stage));
+        write(histogram.getMaxTime());
+        for (unsigned char bucket = 0; bucket < EngineDiagnostics::bucketCount; ++bucket)
+        {
+            write(histogram.getBucket(bucket));
+        }
+    }
+
+    engineDiagnosticsCharacteristic->setValue(temp.data(), temp.size());
+}
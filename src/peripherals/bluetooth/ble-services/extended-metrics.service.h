@@ -47,6 +47,8 @@ class ExtendedMetricBleService final : public IExtendedMetricBleService
 
     } deltaTimesParams;
 
+    NimBLECharacteristic *engineDiagnosticsCharacteristic = nullptr;
+
 public:
     ExtendedMetricBleService();
 
@@ -61,4 +63,5 @@ public:
     void broadcastHandleForces(const std::vector<float> &handleForces) override;
     void broadcastDeltaTimes(const std::vector<unsigned long> &deltaTimes) override;
     void broadcastExtendedMetrics(Configurations::precision avgStrokePower, unsigned int recoveryDuration, unsigned int driveDuration, Configurations::precision dragCoefficient) override;
+    void setEngineDiagnostics(const EngineDiagnostics &diagnostics) override;
 };
@@ -4,6 +4,7 @@
 
 #include "NimBLEDevice.h"
 
+#include "../../../rower/engine-diagnostics.h"
 #include "../../../utils/configuration.h"
 
 using std::vector;
@@ -25,4 +26,5 @@ public:
     virtual void broadcastHandleForces(const std::vector<float> &handleForces) = 0;
     virtual void broadcastDeltaTimes(const std::vector<unsigned long> &deltaTimes) = 0;
     virtual void broadcastExtendedMetrics(Configurations::precision avgStrokePower, unsigned int recoveryDuration, unsigned int driveDuration, Configurations::precision dragCoefficient) = 0;
+    virtual void setEngineDiagnostics(const EngineDiagnostics &diagnostics) = 0;
 };
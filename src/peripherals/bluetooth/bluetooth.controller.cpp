@@ -248,6 +248,14 @@ void BluetoothController::notifyNewMetrics(const RowingDataModels::RowingMetrics
     lastMetricsBroadcastTime = millis();
 }
 
+void BluetoothController::updateEngineDiagnostics(const EngineDiagnostics &diagnostics)
+{
+    if constexpr (Configurations::hasExtendedBleMetrics && Configurations::enableEngineDiagnostics)
+    {
+        extendedMetricsBleService.setEngineDiagnostics(diagnostics);
+    }
+}
+
 void BluetoothController::flushBleDeltaTimes(const unsigned short mtu = 512U)
 {
     extendedMetricsBleService.broadcastDeltaTimes(bleDeltaTimes);
@@ -62,6 +62,7 @@ public:
     void notifyBattery(unsigned char batteryLevel) const override;
     void notifyNewDeltaTime(unsigned long deltaTime) override;
     void notifyNewMetrics(const RowingDataModels::RowingMetrics &data) override;
+    void updateEngineDiagnostics(const EngineDiagnostics &diagnostics) override;
 
     bool isAnyDeviceConnected() override;
 };
\ No newline at end of file
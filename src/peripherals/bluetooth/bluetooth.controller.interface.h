@@ -2,6 +2,7 @@
 
 #include <vector>
 
+#include "../../rower/engine-diagnostics.h"
 #include "../../rower/stroke.model.h"
 
 class IBluetoothController
@@ -18,6 +19,7 @@ public:
     virtual void notifyBattery(unsigned char batteryLevel) const = 0;
     virtual void notifyNewDeltaTime(unsigned long deltaTime) = 0;
     virtual void notifyNewMetrics(const RowingDataModels::RowingMetrics &data) = 0;
+    virtual void updateEngineDiagnostics(const EngineDiagnostics &diagnostics) = 0;
 
     virtual bool isAnyDeviceConnected() = 0;
 };
@@ -131,6 +131,11 @@ void PeripheralsController::updateData(const RowingDataModels::RowingMetrics &da
     }
 }
 
+void PeripheralsController::updateEngineDiagnostics(const EngineDiagnostics &diagnostics)
+{
+    bluetoothController.updateEngineDiagnostics(diagnostics);
+}
+
 void PeripheralsController::setupConnectionIndicatorLed()
 {
     if constexpr (Configurations::ledPin == GPIO_NUM_NC)
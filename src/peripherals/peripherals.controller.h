@@ -35,6 +35,7 @@ public:
     void update(unsigned char batteryLevel) override;
     void notifyBattery(unsigned char batteryLevel) override;
     void updateData(const RowingDataModels::RowingMetrics &data) override;
+    void updateEngineDiagnostics(const EngineDiagnostics &diagnostics) override;
     void updateDeltaTime(unsigned long deltaTime) override;
     bool isAnyDeviceConnected() override;
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../rower/engine-diagnostics.h"
 #include "../rower/stroke.model.h"
 
 class IPeripheralsController
@@ -13,5 +14,6 @@ public:
     virtual void notifyBattery(unsigned char batteryLevel) = 0;
     virtual void updateData(const RowingDataModels::RowingMetrics &data) = 0;
     virtual void updateDeltaTime(unsigned long deltaTime) = 0;
+    virtual void updateEngineDiagnostics(const EngineDiagnostics &diagnostics) = 0;
     virtual bool isAnyDeviceConnected() = 0;
 };
@@ -33,6 +33,13 @@
 #define MINIMUM_RECOVERY_TIME 145
 #define MINIMUM_DRIVE_TIME 170
 #define IMPULSE_DATA_ARRAY_LENGTH 12
+// #define MIN_IMPULSE_DATA_ARRAY_LENGTH 7 // Only relevant if ANGULAR_ESTIMATOR is ESTIMATOR_SAVITZKY_GOLAY or ESTIMATOR_THEIL_SEN
 // #define FLOATING_POINT_PRECISION PRECISION_DOUBLE
+// #define DELTA_TIME_ARITHMETIC ARITHMETIC_FIXED_POINT
+// #define ANGULAR_ESTIMATOR ESTIMATOR_SAMPLED_THEIL_SEN
+// #define ANGULAR_ESTIMATOR ESTIMATOR_SAVITZKY_GOLAY
+// #define ANGULAR_ESTIMATOR ESTIMATOR_KALMAN
+// #define KALMAN_PROCESS_NOISE 1e6     // Only relevant if ANGULAR_ESTIMATOR is ESTIMATOR_KALMAN
+// #define KALMAN_MEASUREMENT_NOISE 0.005 // Only relevant if ANGULAR_ESTIMATOR is ESTIMATOR_KALMAN
 
 // NOLINTEND(cppcoreguidelines-macro-usage,cppcoreguidelines-macro-to-enum)
\ No newline at end of file
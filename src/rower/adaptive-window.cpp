@@ -0,0 +1,51 @@
+#include "./adaptive-window.h"
+
+AdaptiveWindow::AdaptiveWindow(const unsigned char _minLength, const unsigned char _maxLength) : minLength(_minLength), maxLength(_maxLength), length(_maxLength)
+{
+}
+
+void AdaptiveWindow::startImpulse(const unsigned long now)
+{
+    impulseStartTime = now;
+}
+
+void AdaptiveWindow::finishImpulse(const unsigned long now, const unsigned long deltaTime)
+{
+    const auto processingTime = now - impulseStartTime;
+
+    // Shrinking is immediate (one point per impulse) so a sprint does not overrun for long, while growing needs a window length of impulses in a row that used less than a quarter of their delta time, so the length does not flip back and forth around the threshold
+    if (processingTime * 2 > deltaTime)
+    {
+        calmImpulseCount = 0;
+        if (length > minLength)
+        {
+            --length;
+        }
+
+        return;
+    }
+
+    if (processingTime * 4 > deltaTime)
+    {
+        calmImpulseCount = 0;
+
+        return;
+    }
+
+    ++calmImpulseCount;
+    if (calmImpulseCount < length)
+    {
+        return;
+    }
+
+    calmImpulseCount = 0;
+    if (length < maxLength)
+    {
+        ++length;
+    }
+}
+
+unsigned char AdaptiveWindow::getLength() const
+{
+    return length;
+}
\ No newline at end of file
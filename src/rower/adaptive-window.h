@@ -0,0 +1,18 @@
+#pragma once
+
+// Picks the length of the angular estimator window between the profile minimum and maximum from the measured processing time of the impulses: it shrinks when processing an impulse takes more than half of its delta time (e.g. sprints, or a slower chip running the same profile) and grows back when the impulses leave plenty of headroom (e.g. slow strokes and recoveries) for smoother curves
+class AdaptiveWindow
+{
+    unsigned char minLength = 0;
+    unsigned char maxLength = 0;
+    unsigned char length = 0;
+    unsigned char calmImpulseCount = 0;
+    unsigned long impulseStartTime = 0UL;
+
+public:
+    AdaptiveWindow(unsigned char _minLength, unsigned char _maxLength);
+
+    void startImpulse(unsigned long now);
+    void finishImpulse(unsigned long now, unsigned long deltaTime);
+    unsigned char getLength() const;
+};
\ No newline at end of file
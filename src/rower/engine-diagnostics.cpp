@@ -0,0 +1,43 @@
+#include "./engine-diagnostics.h"
+
+void EngineDiagnostics::startImpulse(const unsigned long now, const unsigned long deltaTime)
+{
+    // The previous impulse overran its deadline if processing it took longer than it took this impulse to arrive
+    if (lastProcessingTime > deltaTime)
+    {
+        ++overrunCount;
+    }
+
+    impulseStartTime = now;
+    stageStartTime = now;
+}
+
+void EngineDiagnostics::finishStage(const EngineStage stage, const unsigned long now)
+{
+    stageHistograms[static_cast<unsigned char>(stage)].record(now - stageStartTime);
+    stageStartTime = now;
+}
+
+void EngineDiagnostics::finishImpulse(const unsigned long now)
+{
+    // Whatever ran after the last finished stage (the phase state machine with the torque, drag factor and metrics calculation) is recorded as the phase state machine stage
+    finishStage(EngineStage::PhaseStateMachine, now);
+
+    lastProcessingTime = now - impulseStartTime;
+    stageHistograms[static_cast<unsigned char>(EngineStage::Total)].record(lastProcessingTime);
+}
+
+const TimingHistogram<EngineDiagnostics::bucketCount> &EngineDiagnostics::getHistogram(const EngineStage stage) const
+{
+    return stageHistograms[static_cast<unsigned char>(stage)];
+}
+
+unsigned long EngineDiagnostics::getOverrunCount() const
+{
+    return overrunCount;
+}
+
+unsigned long EngineDiagnostics::getLastProcessingTime() const
+{
+    return lastProcessingTime;
+}
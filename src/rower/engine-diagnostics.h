@@ -0,0 +1,30 @@
+#pragma once
+
+#include <array>
+
+#include "../utils/configuration.h"
+#include "../utils/timing-histogram.h"
+
+// Execution time statistics of the stroke engine, one histogram per stage of processing an impulse (see EngineStage) plus the count of deadline overruns, i.e. impulses whose processing took longer than the delta time to the next impulse. Written by the stroke engine only, readers on other tasks get a copy of it that the stroke service publishes at the end of every stroke (see StrokeService::getDiagnostics())
+class EngineDiagnostics
+{
+public:
+    static constexpr unsigned char bucketCount = 16;
+    static constexpr unsigned char stageCount = static_cast<unsigned char>(EngineStage::Total) + 1;
+
+private:
+    std::array<TimingHistogram<bucketCount>, stageCount> stageHistograms{};
+    unsigned long overrunCount = 0UL;
+    unsigned long impulseStartTime = 0UL;
+    unsigned long stageStartTime = 0UL;
+    unsigned long lastProcessingTime = 0UL;
+
+public:
+    void startImpulse(unsigned long now, unsigned long deltaTime);
+    void finishStage(EngineStage stage, unsigned long now);
+    void finishImpulse(unsigned long now);
+
+    const TimingHistogram<bucketCount> &getHistogram(EngineStage stage) const;
+    unsigned long getOverrunCount() const;
+    unsigned long getLastProcessingTime() const;
+};
@@ -19,26 +19,35 @@ void FlywheelService::setup()
 
 RowingDataModels::FlywheelData FlywheelService::getData()
 {
-    detachRotationInterrupt();
-    isDataChanged = false;
+    // Returns the oldest queued impulse, so calling this while hasDataChanged() is true drains every impulse in order without disabling the interrupt
+    QueuedImpulse impulse{};
+    if (impulses.pop(impulse))
+    {
+        lastQueuedRawImpulseTime = impulse.rawImpulseTime;
+        lastQueueTime = impulse.queueTime;
+        cleanDeltaTime = impulse.rawImpulseTime - lastCleanImpulseTime;
+        totalTime = totalTime + cleanDeltaTime;
+        impulseCount = impulseCount + 1;
+        lastCleanImpulseTime = impulse.rawImpulseTime;
+        totalAngularDisplacement = totalAngularDisplacement + Configurations::angularDisplacementPerImpulse;
+    }
 
-    RowingDataModels::FlywheelData data = {
+    return RowingDataModels::FlywheelData{
         .rawImpulseCount = impulseCount,
         .deltaTime = cleanDeltaTime,
         .totalTime = totalTime,
         .totalAngularDisplacement = totalAngularDisplacement,
         .cleanImpulseTime = lastCleanImpulseTime,
-        // TODO: These serve debugging purposes, may be deleted
-        .rawImpulseTime = lastRawImpulseTime,
+        // Debugging aid: the interrupt timestamp of the impulse as it was queued, before any filtering on the consumer side
+        .rawImpulseTime = lastQueuedRawImpulseTime,
+        .queueTime = lastQueueTime,
+        .droppedImpulseCount = impulses.getOverflowCount(),
     };
-    attachRotationInterrupt();
-
-    return data;
 }
 
 bool FlywheelService::hasDataChanged() const
 {
-    return isDataChanged;
+    return !impulses.isEmpty();
 }
 
 void FlywheelService::processRotation(const unsigned long now)
@@ -50,12 +59,8 @@ void FlywheelService::processRotation(const unsigned long now)
         return;
     }
 
-    isDataChanged = true;
-
     lastRawImpulseTime = now;
 
-    const auto currentDeltaTime = now - lastCleanImpulseTime;
-
     // auto deltaTimeDiffPair = minmax<volatile unsigned long>(currentDeltaTime, lastDeltaTime);
     // auto deltaImpulseTimeDiff = deltaTimeDiffPair.second - deltaTimeDiffPair.first;
 
@@ -65,9 +70,8 @@ void FlywheelService::processRotation(const unsigned long now)
     // if (deltaImpulseTimeDiff > currentDeltaTime && cyclePhase == CyclePhase::Recovery)
     //     return;
 
-    cleanDeltaTime = currentDeltaTime /* lastDeltaTime */;
-    totalTime = totalTime + cleanDeltaTime;
-    impulseCount = impulseCount + 1;
-    lastCleanImpulseTime = now;
-    totalAngularDisplacement = totalAngularDisplacement + Configurations::angularDisplacementPerImpulse;
+    impulses.push(QueuedImpulse{
+        .rawImpulseTime = now,
+        .queueTime = micros(),
+    });
 }
\ No newline at end of file
@@ -1,21 +1,33 @@
 #pragma once
 
 #include "../utils/configuration.h"
+#include "../utils/spsc-ring-buffer.h"
 #include "./flywheel.service.interface.h"
 #include "./stroke.model.h"
 
 class FlywheelService final : public IFlywheelService
 {
-    volatile unsigned long lastDeltaTime = 0;
-    volatile unsigned long cleanDeltaTime = 0;
-    volatile unsigned long lastRawImpulseTime = 0;
-    volatile unsigned long lastCleanImpulseTime = 0;
-    volatile double totalAngularDisplacement = 0;
+    // The interrupt only debounces and queues the impulse times (owned by the interrupt), everything derived from them is calculated on the consumer side when the impulses are read
+    static constexpr unsigned int impulseRingCapacity = 64;
 
-    volatile unsigned long impulseCount = 0UL;
-    volatile unsigned long long totalTime = 0ULL;
+    // An impulse as seen by the interrupt, the ring carries it to the consumer unchanged
+    struct QueuedImpulse
+    {
+        unsigned long rawImpulseTime;
+        unsigned long queueTime;
+    };
 
-    volatile bool isDataChanged = false;
+    unsigned long lastRawImpulseTime = 0;
+    SpscRingBuffer<QueuedImpulse, impulseRingCapacity> impulses;
+
+    unsigned long cleanDeltaTime = 0;
+    unsigned long lastCleanImpulseTime = 0;
+    unsigned long lastQueuedRawImpulseTime = 0;
+    unsigned long lastQueueTime = 0;
+    Configurations::accumulatorPrecision totalAngularDisplacement = 0;
+
+    unsigned long impulseCount = 0UL;
+    unsigned long long totalTime = 0ULL;
 
 public:
     FlywheelService();
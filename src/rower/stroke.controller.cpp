@@ -1,5 +1,6 @@
 #include <cmath>
 
+#include "Arduino.h"
 #include "ArduinoLog.h"
 
 #include "./stroke.controller.h"
@@ -11,58 +12,132 @@ StrokeController::StrokeController(IStrokeService &_strokeService, IFlywheelServ
 void StrokeController::begin()
 {
     Log.infoln("Setting up rowing monitor controller");
-    flywheelService.setup();
 #if ENABLE_RUNTIME_SETTINGS
     strokeService.setup(eepromService.getMachineSettings());
 #endif
+
+    // The task is started before the interrupt is attached so no impulse is queued without a notification
+    xTaskCreatePinnedToCore(
+        strokeTask,
+        "strokeTask",
+        strokeTaskStackSize,
+        this,
+        strokeTaskPriority,
+        &strokeTaskHandle,
+        strokeTaskCoreId);
+
+    flywheelService.setup();
 }
 
-void StrokeController::update()
+void StrokeController::strokeTask(void *parameters)
 {
-    if (flywheelService.hasDataChanged())
+    auto *const strokeController = static_cast<StrokeController *>(parameters);
+
+    // Sleeps until the rotation interrupt gives a notification and then catches up with every impulse queued since the last wake up. Notifications given while a batch is being processed are accumulated, so no impulse is left waiting for the next one. On the device the wait never times out, it only returns zero when there is no scheduler (e.g. on the host)
+    while (ulTaskNotifyTake(pdTRUE, portMAX_DELAY) > 0)
     {
-        const auto lastFlywheelData = flywheelData;
-        flywheelData = flywheelService.getData();
-        if (lastFlywheelData.rawImpulseTime != flywheelData.rawImpulseTime)
+        strokeController->processImpulses();
+    }
+
+    vTaskDelete(nullptr);
+}
+
+void IRAM_ATTR StrokeController::notifyImpulseFromISR()
+{
+    if (strokeTaskHandle == nullptr)
+    {
+        return;
+    }
+
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(strokeTaskHandle, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+void StrokeController::processImpulses()
+{
+    // Every impulse queued by the interrupt since the last run is processed in order, not just the latest one
+    unsigned int queueDepth = 0U;
+    while (flywheelService.hasDataChanged())
+    {
+        // Nothing is logged here: the serial output would block the stroke task, the main loop logs from the published flywheel data and the impulse events instead
+        const auto lastFlywheelData = engineFlywheelData;
+        engineFlywheelData = flywheelService.getData();
+        if (lastFlywheelData.rawImpulseCount == engineFlywheelData.rawImpulseCount)
         {
-            Log.verboseln("rawImpulseTime: %u", flywheelData.rawImpulseTime);
+            break;
         }
 
-        if (lastFlywheelData.rawImpulseCount == flywheelData.rawImpulseCount)
+        strokeService.processData(engineFlywheelData);
+        publishedFlywheelData.back() = engineFlywheelData;
+        publishedFlywheelData.publish();
+        ++queueDepth;
+
+        // The lag is the time from the interrupt to the end of processing the impulse, so it includes both the wait in the queue and the engine itself. It is measured from the queue time as the impulse time may be on a different (e.g. simulated) clock
+        const auto impulseLag = micros() - engineFlywheelData.queueTime;
+        if (impulseLag > maxImpulseLag.load(std::memory_order_relaxed))
         {
-            return;
+            maxImpulseLag.store(impulseLag, std::memory_order_relaxed);
         }
+    }
+
+    if (queueDepth > maxQueueDepth.load(std::memory_order_relaxed))
+    {
+        maxQueueDepth.store(queueDepth, std::memory_order_relaxed);
+    }
+}
+
+void StrokeController::update()
+{
+    // Without a running stroke task (e.g. before begin() or in the e2e tests) the queued impulses are processed in line, as the loop used to do
+    if (strokeTaskHandle == nullptr)
+    {
+        processImpulses();
+    }
 
-        Log.traceln("deltaTime: %u", flywheelData.deltaTime);
+    // The rowing metrics are read in place from the buffer acquired here (it stays unchanged until the next acquire), only the (small) flywheel data of the last impulse is copied for the loop
+    acquireData();
+    const auto lastFlywheelData = flywheelData;
+    flywheelData = publishedFlywheelData.read();
+    if (lastFlywheelData.rawImpulseTime != flywheelData.rawImpulseTime)
+    {
+        Log.verboseln("rawImpulseTime: %u", flywheelData.rawImpulseTime);
+    }
 
-        strokeService.processData(flywheelData);
-        rowerState = strokeService.getData();
+    if (lastFlywheelData.droppedImpulseCount != flywheelData.droppedImpulseCount)
+    {
+        Log.warningln("Impulse queue overflowed, %u impulses dropped in total", flywheelData.droppedImpulseCount);
     }
 }
 
+void StrokeController::acquireData()
+{
+    strokeService.acquireData();
+}
+
 const RowingDataModels::RowingMetrics &StrokeController::getAllData() const
 {
-    return rowerState;
+    return strokeService.getData();
 }
 
 unsigned long long StrokeController::getLastRevTime() const
 {
-    return rowerState.lastRevTime;
+    return strokeService.getData().lastRevTime;
 }
 
 unsigned int StrokeController::getRevCount() const
 {
-    return lround(rowerState.distance);
+    return lround(strokeService.getData().distance);
 }
 
 unsigned long long StrokeController::getLastStrokeTime() const
 {
-    return rowerState.lastStrokeTime;
+    return strokeService.getData().lastStrokeTime;
 }
 
 unsigned short StrokeController::getStrokeCount() const
 {
-    return rowerState.strokeCount;
+    return strokeService.getData().strokeCount;
 }
 
 unsigned long StrokeController::getRawImpulseCount() const
@@ -82,55 +157,60 @@ unsigned long StrokeController::getDeltaTime() const
 
 Configurations::precision StrokeController::getDriveDuration() const
 {
-    return rowerState.driveDuration / 1e6;
+    return strokeService.getData().driveDuration / 1e6;
 }
 
 Configurations::precision StrokeController::getRecoveryDuration() const
 {
-    return rowerState.recoveryDuration / 1e6;
+    return strokeService.getData().recoveryDuration / 1e6;
 }
 
 short StrokeController::getAvgStrokePower() const
 {
-    return static_cast<short>(round(rowerState.avgStrokePower));
+    return static_cast<short>(round(strokeService.getData().avgStrokePower));
 }
 
 Configurations::precision StrokeController::getDistance() const
 {
-    return rowerState.distance;
+    return strokeService.getData().distance;
 }
 
 unsigned char StrokeController::getDragFactor() const
 {
-    return lround(rowerState.dragCoefficient * 1e6);
+    return lround(strokeService.getData().dragCoefficient * 1e6);
 }
 
-unsigned int StrokeController::getPreviousRevCount() const
+unsigned int StrokeController::getMaxQueueDepth() const
 {
-    return previousRevCount;
+    return maxQueueDepth.load(std::memory_order_relaxed);
 }
 
-unsigned int StrokeController::getPreviousStrokeCount() const
+unsigned long StrokeController::getMaxImpulseLag() const
 {
-    return previousStrokeCount;
+    return maxImpulseLag.load(std::memory_order_relaxed);
 }
 
-unsigned long StrokeController::getPreviousRawImpulseCount() const
+EngineDiagnostics StrokeController::getDiagnostics() const
 {
-    return previousRawImpulseCount;
+    return strokeService.getDiagnostics();
 }
 
-void StrokeController::setPreviousRevCount()
+unsigned int StrokeController::getPreviousRevCount() const
 {
-    previousRevCount = lround(rowerState.distance);
+    return previousRevCount;
 }
 
-void StrokeController::setPreviousStrokeCount()
+unsigned int StrokeController::getPreviousStrokeCount() const
 {
-    previousStrokeCount = rowerState.strokeCount;
+    return previousStrokeCount;
+}
+
+void StrokeController::setPreviousRevCount()
+{
+    previousRevCount = lround(strokeService.getData().distance);
 }
 
-void StrokeController::setPreviousRawImpulseCount()
+void StrokeController::setPreviousStrokeCount()
 {
-    previousRawImpulseCount = flywheelData.rawImpulseCount;
+    previousStrokeCount = strokeService.getData().strokeCount;
 }
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <atomic>
+
+#include "Arduino.h"
+
 #include "../utils/EEPROM/EEPROM.service.interface.h"
 #include "../utils/configuration.h"
+#include "../utils/seqlock-snapshot.h"
 #include "./flywheel.service.interface.h"
 #include "./stroke.controller.interface.h"
 #include "./stroke.service.interface.h"
@@ -12,44 +17,55 @@ class StrokeController final : public IStrokeController
     IFlywheelService &flywheelService;
     IEEPROMService &eepromService;
 
+    // The stroke engine runs in its own task on core 1, the core that is not used by the BLE stack (NimBLE and the BT controller are pinned to core 0 via CONFIG_BT_NIMBLE_PINNED_TO_CORE, where the NimBLE host task would preempt the engine). Core 1 is shared with the Arduino loop task (priority 1) that runs the peripherals, the power manager and the logging, but as the engine has a higher priority it preempts the loop as soon as it is notified, so the loop only runs while the engine waits for the next impulse (the loop no longer masks the rotation interrupt either, the impulses are handed over via a lock-free ring). The stack matches the Arduino loop task the engine used to run on
+    static constexpr unsigned int strokeTaskStackSize = 8'192U;
+    static constexpr UBaseType_t strokeTaskPriority = 10U;
+    static constexpr BaseType_t strokeTaskCoreId = 1;
+
+    TaskHandle_t strokeTaskHandle = nullptr;
+
+    // Worst case backlog statistics of the stroke task, written by the task and read by the main loop
+    std::atomic<unsigned int> maxQueueDepth{0U};
+    std::atomic<unsigned long> maxImpulseLag{0UL};
+
     unsigned int previousRevCount = 0;
     unsigned int previousStrokeCount = 0U;
-    unsigned long previousRawImpulseCount = 0U;
 
-    RowingDataModels::RowingMetrics rowerState{
-        0.0,
-        0ULL,
+    RowingDataModels::FlywheelData flywheelData{
+        0UL,
+        0UL,
         0ULL,
-        0U,
-        0U,
-        0U,
-        0.0,
-        0.0,
-        std::vector<float>{},
+        0UL,
+        0UL,
     };
 
-    RowingDataModels::FlywheelData flywheelData{
+    RowingDataModels::FlywheelData engineFlywheelData{
         0UL,
         0UL,
         0ULL,
         0UL,
         0UL,
     };
+    // The flywheel data of the last processed impulse, written by the stroke task and read by the main loop
+    SeqlockSnapshot<RowingDataModels::FlywheelData> publishedFlywheelData;
+
+    static void strokeTask(void *parameters);
 
 public:
     StrokeController(IStrokeService &_strokeService, IFlywheelService &_flywheelService, IEEPROMService &eepromService);
 
     void begin() override;
     void update() override;
+    void processImpulses();
+    void notifyImpulseFromISR();
 
+    void acquireData() override;
     const RowingDataModels::RowingMetrics &getAllData() const override;
     unsigned int getPreviousRevCount() const override;
     void setPreviousRevCount() override;
     unsigned int getPreviousStrokeCount() const override;
     void setPreviousStrokeCount() override;
 
-    unsigned long getPreviousRawImpulseCount() const override;
-    void setPreviousRawImpulseCount() override;
     unsigned long getRawImpulseCount() const override;
     unsigned long getLastImpulseTime() const override;
 
@@ -63,4 +79,8 @@ public:
     Configurations::precision getDriveDuration() const override;
     short getAvgStrokePower() const override;
     unsigned char getDragFactor() const override;
+
+    unsigned int getMaxQueueDepth() const override;
+    unsigned long getMaxImpulseLag() const override;
+    EngineDiagnostics getDiagnostics() const override;
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "../utils/configuration.h"
+#include "./engine-diagnostics.h"
 #include "./stroke.model.h"
 
 class IStrokeController
@@ -10,14 +11,14 @@ public:
     virtual void begin() = 0;
     virtual void update() = 0;
 
+    // Makes the last metrics published by the stroke engine the ones returned by the getters (update() also does this), only to be called from the main loop
+    virtual void acquireData() = 0;
     virtual const RowingDataModels::RowingMetrics &getAllData() const = 0;
     virtual unsigned int getPreviousRevCount() const = 0;
     virtual void setPreviousRevCount() = 0;
     virtual unsigned int getPreviousStrokeCount() const = 0;
     virtual void setPreviousStrokeCount() = 0;
 
-    virtual unsigned long getPreviousRawImpulseCount() const = 0;
-    virtual void setPreviousRawImpulseCount() = 0;
     virtual unsigned long getRawImpulseCount() const = 0;
     virtual unsigned long getLastImpulseTime() const = 0;
 
@@ -31,4 +32,8 @@ public:
     virtual Configurations::precision getDriveDuration() const = 0;
     virtual short getAvgStrokePower() const = 0;
     virtual unsigned char getDragFactor() const = 0;
+
+    virtual unsigned int getMaxQueueDepth() const = 0;
+    virtual unsigned long getMaxImpulseLag() const = 0;
+    virtual EngineDiagnostics getDiagnostics() const = 0;
 };
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "../utils/configuration.h"
+#include "../utils/event-bus.h"
 
 namespace RowingDataModels
 {
@@ -11,9 +12,13 @@ namespace RowingDataModels
         unsigned long rawImpulseCount;
         unsigned long deltaTime;
         unsigned long long totalTime;
-        Configurations::precision totalAngularDisplacement;
+        Configurations::accumulatorPrecision totalAngularDisplacement;
         unsigned long cleanImpulseTime;
         unsigned long rawImpulseTime;
+        // micros() when the interrupt queued the impulse, so the queue and processing delay is measured on the same clock as the consumer even if the impulse times are simulated (e.g. on the host)
+        unsigned long queueTime;
+        // Impulses dropped by the interrupt because the impulse queue was full
+        unsigned long droppedImpulseCount;
     };
 
     struct RowingMetrics
@@ -28,4 +33,15 @@ namespace RowingDataModels
         Configurations::precision dragCoefficient;
         std::vector<float> driveHandleForces;
     };
-}
\ No newline at end of file
+
+    // Emitted by the stroke engine, subscribers read the details from the published metrics (only the delta time of every impulse is carried along so none is lost when impulses are processed in a batch)
+    struct MetricsEvent
+    {
+        MetricsEventType type;
+        unsigned long rawImpulseCount;
+        unsigned long deltaTime;
+    };
+}
+
+// Subscribers: peripherals and logging on the device
+typedef EventBus<RowingDataModels::MetricsEvent, 4, 64> MetricsEventBus;
\ No newline at end of file
@@ -12,14 +12,16 @@
 
 using RowingDataModels::RowingMetrics;
 
-StrokeService::StrokeService()
+StrokeService::StrokeService(MetricsEventBus &_eventBus, const ProcessingClock _processingClock) : eventBus(_eventBus), metrics([](MetricsSnapshot &snapshot)
+                                                                                                                                { snapshot.metrics.driveHandleForces.reserve(Configurations::driveHandleForcesMaxCapacity); }),
+                                                                                                                        processingClock(_processingClock)
 {
-    angularVelocityMatrix.reserve(Configurations::impulseDataArrayLength);
-    angularAccelerationMatrix.reserve(Configurations::impulseDataArrayLength);
     driveHandleForces.reserve(Configurations::driveHandleForcesMaxCapacity);
+    publishedDriveHandleForces.reserve(Configurations::driveHandleForcesMaxCapacity);
 
     deltaTimes.push(0, 0);
-    angularDistances.push(0, 0);
+    angularHistoryX.push(0);
+    angularHistoryY.push(0);
 }
 
 #if ENABLE_RUNTIME_SETTINGS
@@ -29,11 +31,58 @@ void StrokeService::setup(RowerProfile::MachineSettings newMachineSettings)
 }
 #endif
 
+bool StrokeService::isDrivePlausible()
+{
+    // Until the delta time window fills up the startup is processed in full, afterwards a stopped flywheel that is not accelerating cannot start a drive
+    return cyclePhase != CyclePhase::Stopped || deltaTimes.size() < Configurations::impulseDataArrayLength || deltaTimes.coefficientA() < 0;
+}
+
+void StrokeService::warmUpAngularDerivatives()
+{
+    const auto historyX = angularHistoryX.values();
+    const auto historyY = angularHistoryY.values();
+
+    // After a short pause the skipped points (and the current one) are still in the history, so pushing them brings the angular state to exactly where processing every impulse would have left it
+    if (skippedAngularPoints < angularHistoryLength)
+    {
+        for (unsigned char i = historyX.size() - skippedAngularPoints - 1; i < historyX.size(); ++i)
+        {
+            angularEstimator.push(historyX[i], historyY[i]);
+        }
+        skippedAngularPoints = 0;
+
+        return;
+    }
+
+    // After a longer pause the state is rebuilt: for the regression estimators the derivatives of the points in the window are the weighted average of the regressions of the last window length of impulses, each of which needs a full window of points, hence the history of two windows (less one) is replayed (the Kalman filter simply converges on the same points)
+    angularEstimator.reset();
+
+    for (unsigned char i = 0; i < historyX.size(); ++i)
+    {
+        angularEstimator.push(historyX[i], historyY[i]);
+    }
+    skippedAngularPoints = 0;
+}
+
+Configurations::accumulatorPrecision StrokeService::torque()
+{
+    // The angular estimator only takes in the new point on every impulse (the regression estimators keep the coefficients of each regression, the Savitzky-Golay estimator the point), the derivatives at the oldest point of the window are evaluated when they are read here. So the derivatives and the torque are only calculated when the phase state machine needs them, and memoised so they are calculated at most once per impulse, with the drag coefficient at the time of the first read
+    if (!isTorqueCalculated)
+    {
+        currentAngularVelocity = angularEstimator.angularVelocity();
+        currentAngularAcceleration = angularEstimator.angularAcceleration();
+        currentTorque = Configurations::flywheelInertia * currentAngularAcceleration + dragCoefficient * pow(currentAngularVelocity, 2);
+        isTorqueCalculated = true;
+    }
+
+    return currentTorque;
+}
+
 bool StrokeService::isFlywheelUnpowered()
 {
     if constexpr (Configurations::strokeDetectionType != StrokeDetectionType::Slope)
     {
-        if (deltaTimesSlopes.size() >= Configurations::impulseDataArrayLength && ((currentTorque < Configurations::minimumDragTorque && deltaTimes.coefficientA() > 0) || std::abs(deltaTimesSlopes.slope()) < Configurations::minimumRecoverySlopeMargin))
+        if (deltaTimesSlopes.size() >= Configurations::impulseDataArrayLength && ((deltaTimes.coefficientA() > 0 && torque() < Configurations::minimumDragTorque) || std::abs(deltaTimesSlopes.slope()) < Configurations::minimumRecoverySlopeMargin))
         {
             if constexpr (Configurations::logCalibration)
             {
@@ -57,7 +106,8 @@ bool StrokeService::isFlywheelUnpowered()
 
 bool StrokeService::isFlywheelPowered()
 {
-    return currentTorque > Configurations::minimumPoweredTorque && deltaTimes.coefficientA() < 0;
+    // The memoised delta time slope is checked first, so the torque is only calculated when the flywheel is accelerating
+    return deltaTimes.coefficientA() < 0 && torque() > Configurations::minimumPoweredTorque;
 }
 
 void StrokeService::calculateDragCoefficient()
@@ -106,12 +156,16 @@ void StrokeService::driveStart()
     driveStartAngularDisplacement = rowingTotalAngularDisplacement;
 
     driveHandleForces.clear();
-    driveHandleForces.push_back(static_cast<float>(currentTorque) / Configurations::sprocketRadius);
+    driveHandleForces.push_back(static_cast<float>(torque()) / Configurations::sprocketRadius);
+
+    publishedDriveHandleForces.clear();
+    ++driveHandleForcesVersion;
+    queuePhaseEvent(MetricsEventType::DriveStarted);
 
     if constexpr (Configurations::strokeDetectionType != StrokeDetectionType::Slope)
     {
         deltaTimesSlopes.reset();
-        deltaTimesSlopes.push(static_cast<Configurations::precision>(rowingTotalTime), deltaTimes.coefficientA());
+        deltaTimesSlopes.push(static_cast<Configurations::accumulatorPrecision>(rowingTotalTime), deltaTimes.coefficientA());
     }
 }
 
@@ -124,6 +178,7 @@ void StrokeService::driveUpdate()
         {
             dragCoefficient = 0;
             dragCoefficients.reset();
+            isDragCoefficientPending = true;
         }
         recoveryStart();
 
@@ -132,10 +187,10 @@ void StrokeService::driveUpdate()
         return;
     }
 
-    driveHandleForces.push_back(static_cast<float>(currentTorque) / Configurations::sprocketRadius);
+    driveHandleForces.push_back(static_cast<float>(torque()) / Configurations::sprocketRadius);
     if constexpr (Configurations::strokeDetectionType != StrokeDetectionType::Slope)
     {
-        deltaTimesSlopes.push(static_cast<Configurations::precision>(rowingTotalTime), deltaTimes.coefficientA());
+        deltaTimesSlopes.push(static_cast<Configurations::accumulatorPrecision>(rowingTotalTime), deltaTimes.coefficientA());
     }
 }
 
@@ -152,6 +207,11 @@ void StrokeService::driveEnd()
     {
         logNewStrokeData();
     }
+
+    // The finished force curve changes hands by swap, the engine gets the storage of the previous curve that driveStart() clears
+    publishedDriveHandleForces.swap(driveHandleForces);
+    ++driveHandleForcesVersion;
+    queuePhaseEvent(MetricsEventType::StrokeCompleted);
 }
 
 void StrokeService::recoveryStart()
@@ -160,14 +220,14 @@ void StrokeService::recoveryStart()
     recoveryStartTime = rowingTotalTime;
     recoveryStartAngularDisplacement = rowingTotalAngularDisplacement;
     recoveryStartDistance = distance;
-    recoveryDeltaTimes.push(static_cast<Configurations::precision>(rowingTotalTime), deltaTimes.yAtSeriesBegin());
+    recoveryDeltaTimes.push(static_cast<Configurations::deltaTimePrecision>(rowingTotalTime), deltaTimes.yAtSeriesBegin());
 }
 
 void StrokeService::recoveryUpdate()
 {
     if (rowingTotalTime - recoveryStartTime < Configurations::maxDragFactorRecoveryPeriod)
     {
-        recoveryDeltaTimes.push(static_cast<Configurations::precision>(rowingTotalTime), deltaTimes.yAtSeriesBegin());
+        recoveryDeltaTimes.push(static_cast<Configurations::deltaTimePrecision>(rowingTotalTime), deltaTimes.yAtSeriesBegin());
     }
 }
 
@@ -175,7 +235,12 @@ void StrokeService::recoveryEnd()
 {
     recoveryDuration = rowingTotalTime - recoveryStartTime;
     recoveryTotalAngularDisplacement = rowingTotalAngularDisplacement - recoveryStartAngularDisplacement;
+    const auto previousDragCoefficient = dragCoefficient;
     calculateDragCoefficient();
+    if (dragCoefficient != previousDragCoefficient)
+    {
+        isDragCoefficientPending = true;
+    }
 
     recoveryDeltaTimes.reset();
     calculateAvgStrokePower();
@@ -188,51 +253,162 @@ void StrokeService::recoveryEnd()
     }
 }
 
-RowingDataModels::RowingMetrics StrokeService::getData()
+void StrokeService::publishMetrics()
+{
+    auto &snapshot = metrics.back().metrics;
+    snapshot.distance = static_cast<Configurations::precision>(distance);
+    snapshot.lastRevTime = revTime;
+    snapshot.lastStrokeTime = strokeTime;
+    snapshot.strokeCount = strokeCount;
+    snapshot.driveDuration = driveDuration;
+    snapshot.recoveryDuration = recoveryDuration;
+    snapshot.avgStrokePower = static_cast<Configurations::precision>(avgStrokePower);
+    snapshot.dragCoefficient = static_cast<Configurations::precision>(dragCoefficient);
+
+    // The force curve only changes at the phase boundaries, so each buffer copies it (into its reserved storage) at most once per change instead of on every publish. It can not be swapped into the back buffer, as the buffers published after the boundary need the same curve while the reader owns the one that got it
+    if (metrics.back().driveHandleForcesVersion != driveHandleForcesVersion)
+    {
+        snapshot.driveHandleForces.assign(cbegin(publishedDriveHandleForces), cend(publishedDriveHandleForces));
+        metrics.back().driveHandleForcesVersion = driveHandleForcesVersion;
+    }
+
+    metrics.publish();
+
+    // The drag factor is calculated at the end of the recovery, but it only becomes visible with the next publish
+    if (isDragCoefficientPending)
+    {
+        isDragCoefficientPending = false;
+        emitEvent(MetricsEventType::DragFactorUpdated);
+    }
+}
+
+void StrokeService::queuePhaseEvent(const MetricsEventType type)
+{
+    // A phase boundary changes the metrics of the impulse, so its event waits for the publish at the end of the impulse (there is at most one boundary per impulse)
+    pendingPhaseEvent = type;
+    isPhaseEventPending = true;
+}
+
+void StrokeService::emitEvent(const MetricsEventType type, const RowingDataModels::FlywheelData data)
+{
+    eventBus.publish(RowingDataModels::MetricsEvent{
+        .type = type,
+        .rawImpulseCount = data.rawImpulseCount,
+        .deltaTime = data.deltaTime,
+    });
+}
+
+void StrokeService::acquireData()
+{
+    metrics.acquire();
+}
+
+const RowingDataModels::RowingMetrics &StrokeService::getData() const
+{
+    return metrics.front().metrics;
+}
+
+EngineDiagnostics StrokeService::getDiagnostics() const
+{
+    return publishedDiagnostics.read();
+}
+
+unsigned int StrokeService::getSkippedTorqueCalculations(const CyclePhase phase) const
+{
+    return skippedTorqueCalculations[static_cast<unsigned char>(phase)];
+}
+
+unsigned char StrokeService::getAngularWindowLength() const
 {
-    return RowingDataModels::RowingMetrics{
-        .distance = distance,
-        .lastRevTime = revTime,
-        .lastStrokeTime = strokeTime,
-        .strokeCount = strokeCount,
-        .driveDuration = driveDuration,
-        .recoveryDuration = recoveryDuration,
-        .avgStrokePower = avgStrokePower,
-        .dragCoefficient = dragCoefficient,
-        .driveHandleForces = driveHandleForces,
-    };
+    return adaptiveWindow.getLength();
 }
 
 void StrokeService::processData(const RowingDataModels::FlywheelData data)
 {
-    deltaTimes.push(static_cast<Configurations::precision>(data.totalTime), static_cast<Configurations::precision>(data.deltaTime));
-    angularDistances.push(static_cast<Configurations::precision>(data.totalTime) / 1e6, data.totalAngularDisplacement);
+    if constexpr (Configurations::enableEngineDiagnostics)
+    {
+        diagnostics.startImpulse(micros(), data.deltaTime);
+    }
+    if constexpr (Configurations::isImpulseDataArrayAdaptive)
+    {
+        adaptiveWindow.startImpulse(processingClock());
+    }
+
+    const auto impulsePhase = cyclePhase;
+    isTorqueCalculated = false;
+
+    processImpulse(data);
 
-    if (angularVelocityMatrix.size() >= Configurations::impulseDataArrayLength)
+    if constexpr (Configurations::enableEngineDiagnostics)
     {
-        angularVelocityMatrix.erase(begin(angularVelocityMatrix));
+        diagnostics.finishImpulse(micros());
+        // The copy for the other tasks is published when a stroke completes (or the session stops), together with the metrics of that impulse
+        if (isPhaseEventPending && pendingPhaseEvent != MetricsEventType::DriveStarted)
+        {
+            publishedDiagnostics.back() = diagnostics;
+            publishedDiagnostics.publish();
+        }
     }
-    if (angularAccelerationMatrix.size() >= Configurations::impulseDataArrayLength)
+#if ANGULAR_ESTIMATOR == ESTIMATOR_SAVITZKY_GOLAY || ANGULAR_ESTIMATOR == ESTIMATOR_THEIL_SEN
+    if constexpr (Configurations::isImpulseDataArrayAdaptive)
     {
-        angularAccelerationMatrix.erase(begin(angularAccelerationMatrix));
+        adaptiveWindow.finishImpulse(processingClock(), data.deltaTime);
+        angularEstimator.setWindowLength(adaptiveWindow.getLength());
     }
+#endif
 
-    angularVelocityMatrix.push_back(WeightedAverageSeries(Configurations::impulseDataArrayLength));
-    angularAccelerationMatrix.push_back(WeightedAverageSeries(Configurations::impulseDataArrayLength));
+    if (!isTorqueCalculated)
+    {
+        ++skippedTorqueCalculations[static_cast<unsigned char>(impulsePhase)];
+    }
 
-    unsigned char i = 0;
-    const auto angularGoodnessOfFit = angularDistances.goodnessOfFit();
-    while (i < angularVelocityMatrix.size())
+    // Distance and revolution time move on every impulse, so the metrics are published once at the end of every impulse and the events of the impulse are only emitted after it, so a subscriber always finds metrics at least as new as the event it handles
+    publishMetrics();
+    if (isPhaseEventPending)
     {
-        angularVelocityMatrix[i].push(angularDistances.firstDerivativeAtPosition(i), angularGoodnessOfFit);
-        angularAccelerationMatrix[i].push(angularDistances.secondDerivativeAtPosition(i), angularGoodnessOfFit);
-        ++i;
+        isPhaseEventPending = false;
+        emitEvent(pendingPhaseEvent);
     }
+    emitEvent(MetricsEventType::ImpulseProcessed, data);
+}
+
+void StrokeService::processImpulse(const RowingDataModels::FlywheelData data)
+{
+    deltaTimes.push(static_cast<Configurations::deltaTimePrecision>(data.totalTime), static_cast<Configurations::deltaTimePrecision>(data.deltaTime));
 
-    currentAngularVelocity = angularVelocityMatrix[0].average();
-    currentAngularAcceleration = angularAccelerationMatrix[0].average();
+    const auto angularPointX = static_cast<Configurations::accumulatorPrecision>(data.totalTime) / 1e6;
+    angularHistoryX.push(angularPointX);
+    angularHistoryY.push(data.totalAngularDisplacement);
 
-    currentTorque = Configurations::flywheelInertia * currentAngularAcceleration + dragCoefficient * pow(currentAngularVelocity, 2);
+    if constexpr (Configurations::enableEngineDiagnostics)
+    {
+        diagnostics.finishStage(EngineStage::DeltaTimeRegression, micros());
+    }
+
+    if (!isDrivePlausible())
+    {
+        // Stopped and not accelerating, so isFlywheelPowered() would be false regardless of the torque: the angular regression is skipped until a drive becomes plausible
+        if (skippedAngularPoints < angularHistoryLength)
+        {
+            ++skippedAngularPoints;
+        }
+
+        return;
+    }
+
+    if (skippedAngularPoints == 0)
+    {
+        angularEstimator.push(angularPointX, data.totalAngularDisplacement);
+    }
+    else
+    {
+        warmUpAngularDerivatives();
+    }
+
+    if constexpr (Configurations::enableEngineDiagnostics)
+    {
+        diagnostics.finishStage(EngineStage::AngularRegression, micros());
+    }
 
     // If rotation delta exceeds the max debounce time and we are in Recovery Phase, the rower must have stopped. Setting cyclePhase to "Stopped"
     if (cyclePhase == CyclePhase::Recovery && rowingTotalTime - recoveryStartTime > Configurations::rowingStoppedThresholdPeriod)
@@ -243,6 +419,10 @@ void StrokeService::processData(const RowingDataModels::FlywheelData data)
         driveDuration = 0;
         avgStrokePower = 0;
 
+        publishedDriveHandleForces.clear();
+        ++driveHandleForcesVersion;
+        queuePhaseEvent(MetricsEventType::SessionStopped);
+
         return;
     }
 
@@ -310,7 +490,8 @@ void StrokeService::processData(const RowingDataModels::FlywheelData data)
 
 void StrokeService::logSlopeMarginDetection() const
 {
-    if (deltaTimesSlopes.size() >= Configurations::impulseDataArrayLength && currentTorque > Configurations::minimumDragTorque && std::abs(deltaTimesSlopes.slope()) < Configurations::minimumRecoverySlopeMargin)
+    // Only logs with a torque that was already calculated for this impulse, so logging does not change the skipped calculations it reports
+    if (deltaTimesSlopes.size() >= Configurations::impulseDataArrayLength && isTorqueCalculated && currentTorque > Configurations::minimumDragTorque && std::abs(deltaTimesSlopes.slope()) < Configurations::minimumRecoverySlopeMargin)
     {
         Log.infoln("slope margin detect");
     }
@@ -336,4 +517,5 @@ void StrokeService::logNewStrokeData() const
     response.append("]}");
 
     Log.infoln("handleForces: %s", response.c_str());
+    Log.infoln("skippedTorqueCalculations: stopped %d, recovery %d, drive %d", skippedTorqueCalculations[static_cast<unsigned char>(CyclePhase::Stopped)], skippedTorqueCalculations[static_cast<unsigned char>(CyclePhase::Recovery)], skippedTorqueCalculations[static_cast<unsigned char>(CyclePhase::Drive)]);
 }
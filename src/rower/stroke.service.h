@@ -1,15 +1,41 @@
 #pragma once
 
+#include <array>
+#include <vector>
+
 #include "../utils/configuration.h"
+#include "../utils/seqlock-snapshot.h"
+#include "../utils/series/fixed-point-ols-linear-series.h"
+#include "../utils/series/fixed-series.h"
+#include "../utils/series/kalman-angular-estimator.h"
 #include "../utils/series/ols-linear-series.h"
+#include "../utils/series/precision-policy.h"
+#include "../utils/series/quadratic-regression-angular-estimator.h"
+#include "../utils/series/savitzky-golay-angular-estimator.h"
+#include "../utils/series/ts-fixed-point-linear-series.h"
 #include "../utils/series/ts-linear-series.h"
 #include "../utils/series/ts-quadratic-series.h"
+#include "../utils/series/ts-sampled-quadratic-series.h"
 #include "../utils/series/weighted-average-series.h"
+#include "../utils/triple-buffer.h"
+#include "./adaptive-window.h"
+#include "./engine-diagnostics.h"
 #include "./stroke.model.h"
 #include "./stroke.service.interface.h"
 
+using std::vector;
+
 class StrokeService final : public IStrokeService
 {
+    // The pairwise slopes and triple coefficients of the regressions are stored and ordered in the configured precision while their points (total time and angular displacement) and the arithmetic on them use the accumulator precision
+    typedef PrecisionPolicy<Configurations::precision, Configurations::accumulatorPrecision> RegressionPrecision;
+
+public:
+    typedef unsigned long (*ProcessingClock)();
+
+private:
+    MetricsEventBus &eventBus;
+
     // Machine settings
     RowerProfile::MachineSettings machineSettings;
 
@@ -17,47 +43,93 @@ class StrokeService final : public IStrokeService
     CyclePhase cyclePhase = CyclePhase::Stopped;
     unsigned long long rowingTotalTime = 0ULL;
     unsigned long long rowingImpulseCount = 0UL;
-    Configurations::precision rowingTotalAngularDisplacement = 0;
+    Configurations::accumulatorPrecision rowingTotalAngularDisplacement = 0;
 
     // Drive related
     unsigned long long driveStartTime = 0ULL;
     unsigned int driveDuration = 0;
-    Configurations::precision driveStartAngularDisplacement = 0;
-    Configurations::precision driveTotalAngularDisplacement = 0;
+    Configurations::accumulatorPrecision driveStartAngularDisplacement = 0;
+    Configurations::accumulatorPrecision driveTotalAngularDisplacement = 0;
 
     // Recovery related
     unsigned long long recoveryStartTime = 0;
     unsigned int recoveryDuration = 0;
-    Configurations::precision recoveryStartAngularDisplacement = 0;
-    Configurations::precision recoveryTotalAngularDisplacement = 0;
-    Configurations::precision recoveryStartDistance = 0;
+    Configurations::accumulatorPrecision recoveryStartAngularDisplacement = 0;
+    Configurations::accumulatorPrecision recoveryTotalAngularDisplacement = 0;
+    Configurations::accumulatorPrecision recoveryStartDistance = 0;
 
     // metrics
-    Configurations::precision distancePerAngularDisplacement = 0;
-    Configurations::precision distance = 0;
+    Configurations::accumulatorPrecision distancePerAngularDisplacement = 0;
+    Configurations::accumulatorPrecision distance = 0;
     unsigned short strokeCount = 0;
     unsigned long long strokeTime = 0ULL;
     unsigned long long revTime = 0ULL;
-    Configurations::precision avgStrokePower = 0;
+    Configurations::accumulatorPrecision avgStrokePower = 0;
 
-    Configurations::precision dragCoefficient = 0;
+    Configurations::accumulatorPrecision dragCoefficient = 0;
+    bool isDragCoefficientPending = false;
 
     WeightedAverageSeries dragCoefficients = WeightedAverageSeries(Configurations::dragCoefficientsArrayLength);
 
-    // advance metrics
-    Configurations::precision currentAngularVelocity = 0;
-    Configurations::precision currentAngularAcceleration = 0;
-    Configurations::precision currentTorque = 0;
+    // advance metrics (calculated on demand and memoised for the current impulse, see torque())
+    bool isTorqueCalculated = false;
+    Configurations::accumulatorPrecision currentAngularVelocity = 0;
+    Configurations::accumulatorPrecision currentAngularAcceleration = 0;
+    Configurations::accumulatorPrecision currentTorque = 0;
+    // Impulses per cycle phase (indexed by CyclePhase) where the phase state machine did not need the torque, so neither the torque nor the angular derivatives were calculated (for the Kalman filter, which has to update its state on every impulse, only the torque)
+    std::array<unsigned int, 3> skippedTorqueCalculations{};
     vector<float> driveHandleForces;
-
-    vector<WeightedAverageSeries> angularVelocityMatrix;
-    vector<WeightedAverageSeries> angularAccelerationMatrix;
-
-    TSLinearSeries deltaTimes = TSLinearSeries(Configurations::impulseDataArrayLength);
+    // Force curve of the last finished drive (empty during the drive and once stopped), the version tells the metrics buffers whether their copy is outdated
+    vector<float> publishedDriveHandleForces;
+    unsigned int driveHandleForcesVersion = 0U;
+
+    struct MetricsSnapshot
+    {
+        RowingDataModels::RowingMetrics metrics;
+        unsigned int driveHandleForcesVersion;
+    };
+    // Metrics published once at the end of every impulse for the main loop, which reads them in place. The events of the phase boundaries (drive start, drive end and stop) are held back until that publish, so a subscriber always finds metrics at least as new as the event it handles
+    TripleBuffer<MetricsSnapshot> metrics;
+    bool isPhaseEventPending = false;
+    MetricsEventType pendingPhaseEvent = MetricsEventType::ImpulseProcessed;
+
+    // Per stage execution time histograms, only updated when ENABLE_ENGINE_DIAGNOSTICS is set (otherwise the timing calls are compiled out). The engine updates them on every impulse, other tasks only read the copy published at the end of every stroke
+    EngineDiagnostics diagnostics;
+    SeqlockSnapshot<EngineDiagnostics> publishedDiagnostics;
+
+    // Length of the angular estimator window picked from the processing time of the impulses, only used when MIN_IMPULSE_DATA_ARRAY_LENGTH is below IMPULSE_DATA_ARRAY_LENGTH
+    AdaptiveWindow adaptiveWindow = AdaptiveWindow(Configurations::minImpulseDataArrayLength, Configurations::impulseDataArrayLength);
+    // Time source of the adaptive window (micros() on the device), the host simulation injects a deterministic one so the picked window lengths do not depend on the speed of the machine running it
+    ProcessingClock processingClock;
+
+    // Stopped fast path: while stopped and the flywheel is not accelerating only the delta time regression is updated, the angular displacement points are kept in a history that is long enough to rebuild the state of the angular estimator (for the regression estimators every regression window behind the derivative windows) once a drive becomes plausible
+    static constexpr unsigned char angularHistoryLength = Configurations::impulseDataArrayLength * 2 - 1;
+    unsigned char skippedAngularPoints = 0;
+    FixedSeries<angularHistoryLength, Configurations::accumulatorPrecision> angularHistoryX;
+    FixedSeries<angularHistoryLength, Configurations::accumulatorPrecision> angularHistoryY;
+
+#if DELTA_TIME_ARITHMETIC == ARITHMETIC_FIXED_POINT
+    TSFixedPointLinearSeries<Configurations::impulseDataArrayLength> deltaTimes;
+    FixedPointOLSLinearSeries recoveryDeltaTimes;
+#else
+    TSLinearSeries<Configurations::impulseDataArrayLength, RegressionPrecision> deltaTimes;
+    OLSLinearSeries recoveryDeltaTimes;
+#endif
     OLSLinearSeries deltaTimesSlopes = OLSLinearSeries(Configurations::impulseDataArrayLength);
-    OLSLinearSeries recoveryDeltaTimes = OLSLinearSeries(0, Configurations::maxDragFactorRecoveryPeriod / Configurations::rotationDebounceTimeMin / 2);
-    TSQuadraticSeries angularDistances = TSQuadraticSeries(Configurations::impulseDataArrayLength);
+#if ANGULAR_ESTIMATOR == ESTIMATOR_KALMAN
+    KalmanAngularEstimator<Configurations::impulseDataArrayLength> angularEstimator = KalmanAngularEstimator<Configurations::impulseDataArrayLength>(Configurations::kalmanProcessNoise, Configurations::kalmanMeasurementNoise);
+#elif ANGULAR_ESTIMATOR == ESTIMATOR_SAVITZKY_GOLAY
+    SavitzkyGolayAngularEstimator<Configurations::impulseDataArrayLength, Configurations::minImpulseDataArrayLength> angularEstimator;
+#elif ANGULAR_ESTIMATOR == ESTIMATOR_SAMPLED_THEIL_SEN
+    QuadraticRegressionAngularEstimator<TSSampledQuadraticSeries<Configurations::impulseDataArrayLength, Configurations::sampledTheilSenTriplesPerImpulse, RegressionPrecision>, Configurations::impulseDataArrayLength> angularEstimator;
+#else
+    QuadraticRegressionAngularEstimator<TSQuadraticSeries<Configurations::impulseDataArrayLength, RegressionPrecision>, Configurations::impulseDataArrayLength, Configurations::minImpulseDataArrayLength> angularEstimator;
+#endif
 
+    Configurations::accumulatorPrecision torque();
+    void processImpulse(RowingDataModels::FlywheelData data);
+    bool isDrivePlausible();
+    void warmUpAngularDerivatives();
     bool isFlywheelUnpowered();
     bool isFlywheelPowered();
     void calculateDragCoefficient();
@@ -69,17 +141,24 @@ class StrokeService final : public IStrokeService
     void recoveryStart();
     void recoveryUpdate();
     void recoveryEnd();
+    void publishMetrics();
+    void queuePhaseEvent(MetricsEventType type);
+    void emitEvent(MetricsEventType type, RowingDataModels::FlywheelData data = {});
 
     void logSlopeMarginDetection() const;
     void logNewStrokeData() const;
 
 public:
-    StrokeService();
+    explicit StrokeService(MetricsEventBus &_eventBus, ProcessingClock _processingClock = micros);
 
 #if ENABLE_RUNTIME_SETTINGS
     void setup(RowerProfile::MachineSettings newMachineSettings) override;
 #endif
 
-    RowingDataModels::RowingMetrics getData() override;
+    void acquireData() override;
+    const RowingDataModels::RowingMetrics &getData() const override;
+    EngineDiagnostics getDiagnostics() const override;
+    unsigned int getSkippedTorqueCalculations(CyclePhase phase) const;
+    unsigned char getAngularWindowLength() const;
     void processData(RowingDataModels::FlywheelData data) override;
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../utils/settings.model.h"
+#include "./engine-diagnostics.h"
 #include "./stroke.model.h"
 
 class IStrokeService
@@ -12,6 +13,9 @@ public:
 #if ENABLE_RUNTIME_SETTINGS
     virtual void setup(RowerProfile::MachineSettings newMachineSettings) = 0;
 #endif
-    virtual RowingDataModels::RowingMetrics getData() = 0;
+    // Makes the last published metrics the ones returned by getData(), only to be called by the task that reads them
+    virtual void acquireData() = 0;
+    virtual const RowingDataModels::RowingMetrics &getData() const = 0;
+    virtual EngineDiagnostics getDiagnostics() const = 0;
     virtual void processData(RowingDataModels::FlywheelData data) = 0;
 };
\ No newline at end of file
@@ -14,6 +14,10 @@ class Configurations
 {
 public:
     typedef PRECISION precision;
+    // Type of the running totals and of the final torque, drag factor and power arithmetic. These are only updated once per impulse, so they are kept in double even if the regressions use float
+    typedef double accumulatorPrecision;
+    // Type of the delta time (Theil-Sen) and drag factor (OLS) regression inputs: integer microseconds when DELTA_TIME_ARITHMETIC is fixed point
+    typedef IF(DELTA_TIME_ARITHMETIC, long long, accumulatorPrecision) deltaTimePrecision;
 
     static constexpr unsigned char maxConnectionCount = 2;
 
@@ -22,6 +26,7 @@ public:
     static constexpr bool supportSdCardLogging = SUPPORT_SD_CARD_LOGGING;
 
     static constexpr bool isRuntimeSettingsEnabled = ENABLE_RUNTIME_SETTINGS;
+    static constexpr bool enableEngineDiagnostics = ENABLE_ENGINE_DIAGNOSTICS;
 
     // Bluetooth Settings
     static constexpr BleServiceFlag defaultBleServiceFlag = DEFAULT_BLE_SERVICE;
@@ -83,6 +88,11 @@ public:
     static constexpr unsigned int minimumRecoveryTime = MINIMUM_RECOVERY_TIME * 1'000;
     static constexpr unsigned int minimumDriveTime = MINIMUM_DRIVE_TIME * 1'000;
     static constexpr unsigned char impulseDataArrayLength = IMPULSE_DATA_ARRAY_LENGTH;
+    static constexpr unsigned char minImpulseDataArrayLength = MIN_IMPULSE_DATA_ARRAY_LENGTH;
+    static constexpr bool isImpulseDataArrayAdaptive = minImpulseDataArrayLength < impulseDataArrayLength;
+    static constexpr unsigned char sampledTheilSenTriplesPerImpulse = SAMPLED_THEIL_SEN_TRIPLES_PER_IMPULSE;
+    static constexpr float kalmanProcessNoise = KALMAN_PROCESS_NOISE;
+    static constexpr float kalmanMeasurementNoise = KALMAN_MEASUREMENT_NOISE;
 
     // Device power management settings
     static constexpr gpio_num_t batteryPinNumber = BATTERY_PIN_NUMBER;
@@ -16,6 +16,23 @@ enum class CyclePhase : unsigned char
     Drive
 };
 
+enum class MetricsEventType : unsigned char
+{
+    ImpulseProcessed,
+    DriveStarted,
+    StrokeCompleted,
+    DragFactorUpdated,
+    SessionStopped
+};
+
+enum class EngineStage : unsigned char
+{
+    DeltaTimeRegression,
+    AngularRegression,
+    PhaseStateMachine,
+    Total
+};
+
 enum class BleServiceFlag : unsigned char
 {
     CpsService,
@@ -327,6 +344,7 @@ public:
     inline static const std::string extendedMetricsUuid = "808a0d51-efae-4f0c-b2e0-48bc180d65c3";
     inline static const std::string handleForcesUuid = "3d9c2760-cf91-41ee-87e9-fd99d5f129a4";
     inline static const std::string deltaTimesUuid = "ae5d11ea-62f6-4789-b809-6fc93fee92b9";
+    inline static const std::string engineDiagnosticsUuid = "4f179f6c-2be9-496c-b9d7-7c1c10b01ac6";
 
     inline static const std::string otaServiceUuid = "ed249319-32c3-4e9f-83d7-7bb5aa5d5d4b";
     inline static const std::string otaRxUuid = "fbac1540-698b-40ff-a34e-f39e5b78d1cf";
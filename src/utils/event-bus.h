@@ -0,0 +1,134 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <initializer_list>
+
+#include "./spsc-ring-buffer.h"
+
+// Publish/subscribe bus that hands typed events from one publisher (e.g. the stroke engine task) to a fixed number of subscribers without allocating. Every subscriber has its own bounded queue (so a slow consumer cannot hold back the others) and a mask of the event types it is interested in, and its handler only runs when it dispatches a queued event. Subscribing is meant for setup time, before the first event is published
+template <typename Event, unsigned char maxSubscribers, unsigned int queueCapacity>
+class EventBus
+{
+    static_assert(maxSubscribers > 0, "EventBus requires at least one subscriber slot");
+
+public:
+    typedef void (*EventHandler)(const Event &event);
+
+private:
+    struct Subscriber
+    {
+        EventHandler handler = nullptr;
+        unsigned int typeMask = 0U;
+        std::atomic<unsigned int> maxBacklog{0U};
+        SpscRingBuffer<Event, queueCapacity> queue;
+    };
+
+    std::array<Subscriber, maxSubscribers> subscribers{};
+    unsigned char subscriberCount = 0;
+
+    static unsigned int typeBit(decltype(Event::type) type);
+
+public:
+    unsigned char subscribe(EventHandler handler, std::initializer_list<decltype(Event::type)> types);
+    void publish(const Event &event);
+    unsigned int dispatch(unsigned char subscriberId);
+    void dispatchAll();
+
+    unsigned int getBacklog(unsigned char subscriberId) const;
+    unsigned int getMaxBacklog(unsigned char subscriberId) const;
+    unsigned long getDroppedEventCount(unsigned char subscriberId) const;
+};
+
+template <typename Event, unsigned char maxSubscribers, unsigned int queueCapacity>
+unsigned int EventBus<Event, maxSubscribers, queueCapacity>::typeBit(const decltype(Event::type) type)
+{
+    return 1U << static_cast<unsigned char>(type);
+}
+
+template <typename Event, unsigned char maxSubscribers, unsigned int queueCapacity>
+unsigned char EventBus<Event, maxSubscribers, queueCapacity>::subscribe(const EventHandler handler, const std::initializer_list<decltype(Event::type)> types)
+{
+    if (subscriberCount == maxSubscribers)
+    {
+        return maxSubscribers;
+    }
+
+    auto &subscriber = subscribers[subscriberCount];
+    subscriber.handler = handler;
+    for (const auto type : types)
+    {
+        subscriber.typeMask |= typeBit(type);
+    }
+
+    return subscriberCount++;
+}
+
+template <typename Event, unsigned char maxSubscribers, unsigned int queueCapacity>
+void EventBus<Event, maxSubscribers, queueCapacity>::publish(const Event &event)
+{
+    // A full queue drops the new event (and counts it) instead of blocking the publisher
+    const auto bit = typeBit(event.type);
+    for (unsigned char i = 0; i < subscriberCount; ++i)
+    {
+        auto &subscriber = subscribers[i];
+        if ((subscriber.typeMask & bit) == 0U)
+        {
+            continue;
+        }
+
+        subscriber.queue.push(event);
+        const auto backlog = subscriber.queue.size();
+        if (backlog > subscriber.maxBacklog.load(std::memory_order_relaxed))
+        {
+            subscriber.maxBacklog.store(backlog, std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename Event, unsigned char maxSubscribers, unsigned int queueCapacity>
+unsigned int EventBus<Event, maxSubscribers, queueCapacity>::dispatch(const unsigned char subscriberId)
+{
+    if (subscriberId >= subscriberCount)
+    {
+        return 0U;
+    }
+
+    auto &subscriber = subscribers[subscriberId];
+    unsigned int dispatchedCount = 0U;
+    Event event{};
+    while (subscriber.queue.pop(event))
+    {
+        subscriber.handler(event);
+        ++dispatchedCount;
+    }
+
+    return dispatchedCount;
+}
+
+template <typename Event, unsigned char maxSubscribers, unsigned int queueCapacity>
+void EventBus<Event, maxSubscribers, queueCapacity>::dispatchAll()
+{
+    for (unsigned char i = 0; i < subscriberCount; ++i)
+    {
+        dispatch(i);
+    }
+}
+
+template <typename Event, unsigned char maxSubscribers, unsigned int queueCapacity>
+unsigned int EventBus<Event, maxSubscribers, queueCapacity>::getBacklog(const unsigned char subscriberId) const
+{
+    return subscriberId < subscriberCount ? subscribers[subscriberId].queue.size() : 0U;
+}
+
+template <typename Event, unsigned char maxSubscribers, unsigned int queueCapacity>
+unsigned int EventBus<Event, maxSubscribers, queueCapacity>::getMaxBacklog(const unsigned char subscriberId) const
+{
+    return subscriberId < subscriberCount ? subscribers[subscriberId].maxBacklog.load(std::memory_order_relaxed) : 0U;
+}
+
+template <typename Event, unsigned char maxSubscribers, unsigned int queueCapacity>
+unsigned long EventBus<Event, maxSubscribers, queueCapacity>::getDroppedEventCount(const unsigned char subscriberId) const
+{
+    return subscriberId < subscriberCount ? subscribers[subscriberId].queue.getOverflowCount() : 0UL;
+}
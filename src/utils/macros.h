@@ -62,6 +62,12 @@ consteval std::string_view extractClassName(const std::string_view className)
 #define STROKE_DETECTION_TORQUE 0
 #define STROKE_DETECTION_SLOPE 1
 #define STROKE_DETECTION_BOTH 2
+#define ARITHMETIC_FLOATING_POINT 0
+#define ARITHMETIC_FIXED_POINT 1
+#define ESTIMATOR_THEIL_SEN 0
+#define ESTIMATOR_SAMPLED_THEIL_SEN 1
+#define ESTIMATOR_KALMAN 2
+#define ESTIMATOR_SAVITZKY_GOLAY 3
 
 #define CONCAT2(A, B) A##B
 #define CONCAT2_DEFERRED(A, B) CONCAT2(A, B)
@@ -94,6 +100,30 @@ consteval std::string_view extractClassName(const std::string_view className)
     #define STROKE_DETECTION StrokeDetectionType::Torque
 #endif
 
+#if !defined(DELTA_TIME_ARITHMETIC)
+    #define DELTA_TIME_ARITHMETIC ARITHMETIC_FLOATING_POINT
+#endif
+
+#if !defined(ANGULAR_ESTIMATOR)
+    #define ANGULAR_ESTIMATOR ESTIMATOR_THEIL_SEN
+#endif
+
+#if !defined(SAMPLED_THEIL_SEN_TRIPLES_PER_IMPULSE)
+    #define SAMPLED_THEIL_SEN_TRIPLES_PER_IMPULSE 12
+#endif
+
+#if !defined(MIN_IMPULSE_DATA_ARRAY_LENGTH)
+    #define MIN_IMPULSE_DATA_ARRAY_LENGTH IMPULSE_DATA_ARRAY_LENGTH
+#endif
+
+#if !defined(KALMAN_PROCESS_NOISE)
+    #define KALMAN_PROCESS_NOISE 1e8
+#endif
+
+#if !defined(KALMAN_MEASUREMENT_NOISE)
+    #define KALMAN_MEASUREMENT_NOISE 0.02
+#endif
+
 #if !defined(LED_PIN)
     #if defined(LED_BUILTIN)
         #define LED_PIN LED_BUILTIN
@@ -183,6 +213,10 @@ static_assert(((sizeof(SERIAL_NUMBER) - 1 == 0 ? DEFAULT_SERIAL_LENGTH : sizeof(
     #define ENABLE_BLUETOOTH_DELTA_TIME_LOGGING false
 #endif
 
+#if !defined(ENABLE_ENGINE_DIAGNOSTICS)
+    #define ENABLE_ENGINE_DIAGNOSTICS false
+#endif
+
 #if !defined(SUPPORT_SD_CARD_LOGGING)
     #define SUPPORT_SD_CARD_LOGGING false
 #endif
@@ -201,11 +235,35 @@ static_assert(SUPPORT_SD_CARD_LOGGING == false || (SUPPORT_SD_CARD_LOGGING == tr
 #if defined(FLOATING_POINT_PRECISION) && FLOATING_POINT_PRECISION != PRECISION_DOUBLE && FLOATING_POINT_PRECISION != PRECISION_FLOAT
     #error "Invalid floating point precision setting"
 #endif
+#if DELTA_TIME_ARITHMETIC != ARITHMETIC_FLOATING_POINT && DELTA_TIME_ARITHMETIC != ARITHMETIC_FIXED_POINT
+    #error "Invalid delta time arithmetic setting"
+#endif
+#if DELTA_TIME_ARITHMETIC == ARITHMETIC_FIXED_POINT && ROTATION_DEBOUNCE_TIME_MIN > 0
+static_assert(static_cast<long double>(MAX_DRAG_FACTOR_RECOVERY_PERIOD) * 1'000 * (MAX_DRAG_FACTOR_RECOVERY_PERIOD) * 1'000 * ((MAX_DRAG_FACTOR_RECOVERY_PERIOD) / (ROTATION_DEBOUNCE_TIME_MIN) + 1) < 9.2e18, "MAX_DRAG_FACTOR_RECOVERY_PERIOD is too long for the fixed point drag factor regression (its integer sums would overflow), please reduce it or use ARITHMETIC_FLOATING_POINT");
+#endif
 #if IMPULSE_DATA_ARRAY_LENGTH < 3
     #error "IMPULSE_DATA_ARRAY_LENGTH should not be less than 3"
 #endif
-#if IMPULSE_DATA_ARRAY_LENGTH > 18
-    #error "Using too many data points will increase loop execution time. It should not be more than 18"
+#if ANGULAR_ESTIMATOR != ESTIMATOR_THEIL_SEN && ANGULAR_ESTIMATOR != ESTIMATOR_SAMPLED_THEIL_SEN && ANGULAR_ESTIMATOR != ESTIMATOR_KALMAN && ANGULAR_ESTIMATOR != ESTIMATOR_SAVITZKY_GOLAY
+    #error "Invalid angular estimator setting"
+#endif
+#if ANGULAR_ESTIMATOR == ESTIMATOR_SAMPLED_THEIL_SEN && (SAMPLED_THEIL_SEN_TRIPLES_PER_IMPULSE < 1 || SAMPLED_THEIL_SEN_TRIPLES_PER_IMPULSE > 64)
+    #error "SAMPLED_THEIL_SEN_TRIPLES_PER_IMPULSE should be between 1 and 64"
+#endif
+#if ANGULAR_ESTIMATOR == ESTIMATOR_KALMAN
+static_assert(KALMAN_PROCESS_NOISE > 0 && KALMAN_MEASUREMENT_NOISE > 0, "KALMAN_PROCESS_NOISE and KALMAN_MEASUREMENT_NOISE should be positive");
+#endif
+#if ANGULAR_ESTIMATOR == ESTIMATOR_THEIL_SEN && IMPULSE_DATA_ARRAY_LENGTH > 18
+    #error "Using too many data points will increase loop execution time. It should not be more than 18 (or use ESTIMATOR_SAMPLED_THEIL_SEN for larger windows)"
+#endif
+#if MIN_IMPULSE_DATA_ARRAY_LENGTH < 3 || MIN_IMPULSE_DATA_ARRAY_LENGTH > IMPULSE_DATA_ARRAY_LENGTH
+    #error "MIN_IMPULSE_DATA_ARRAY_LENGTH should be between 3 and IMPULSE_DATA_ARRAY_LENGTH"
+#endif
+#if MIN_IMPULSE_DATA_ARRAY_LENGTH < IMPULSE_DATA_ARRAY_LENGTH && ANGULAR_ESTIMATOR != ESTIMATOR_SAVITZKY_GOLAY && ANGULAR_ESTIMATOR != ESTIMATOR_THEIL_SEN
+    #error "An adaptive window (MIN_IMPULSE_DATA_ARRAY_LENGTH less than IMPULSE_DATA_ARRAY_LENGTH) is only supported by ESTIMATOR_SAVITZKY_GOLAY and ESTIMATOR_THEIL_SEN (the cost of ESTIMATOR_SAMPLED_THEIL_SEN is bound by its triples per impulse and the cost of ESTIMATOR_KALMAN does not depend on the window length)"
+#endif
+#if IMPULSE_DATA_ARRAY_LENGTH > 32
+    #error "Using too many data points will increase loop execution time. It should not be more than 32"
 #endif
 
 #if IMPULSE_DATA_ARRAY_LENGTH < 14
@@ -225,7 +283,7 @@ static_assert(SUPPORT_SD_CARD_LOGGING == false || (SUPPORT_SD_CARD_LOGGING == tr
         #define PRECISION IF(FLOATING_POINT_PRECISION, double, float)
     #endif
 #endif
-#if IMPULSE_DATA_ARRAY_LENGTH >= 16 && IMPULSE_DATA_ARRAY_LENGTH < 18
+#if IMPULSE_DATA_ARRAY_LENGTH >= 16
     #if (FLOATING_POINT_PRECISION == PRECISION_DOUBLE)
         #warning "Using too many data points (i.e. setting `IMPULSE_DATA_ARRAY_LENGTH` to a high number) will increase loop execution time. Using 16 and a precision of double would require 3.9-4.7ms to complete all calculation. Hence impulses may be missed. So setting precision to float to save on execution time (but potentially loose some precision). For further details please refer to [docs](docs/settings.md#impulse_data_array_length)"
     #endif
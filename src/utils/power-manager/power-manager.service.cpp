@@ -81,15 +81,7 @@ unsigned char PowerManagerService::measureBattery() const
         batteryLevel = rawNewBatteryLevel;
     }
 
-    const unsigned char mid = Configurations::batteryLevelArrayLength / 2;
-    std::nth_element(begin(batteryLevels), begin(batteryLevels) + mid + 1, end(batteryLevels));
-
-    if constexpr (isOdd(batteryLevels.size()))
-    {
-        return lround(batteryLevels[mid]);
-    }
-
-    return lround((batteryLevels[mid] + *std::max_element(cbegin(batteryLevels), cbegin(batteryLevels) + mid)) / 2);
+    return medianBatteryLevel(batteryLevels);
 }
 
 unsigned char PowerManagerService::setupBatteryMeasurement() const
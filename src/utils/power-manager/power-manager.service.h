@@ -1,5 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 #include "./power-manager.service.interface.h"
 
 class PowerManagerService final : public IPowerManagerService
@@ -14,4 +18,22 @@ public:
     unsigned char setup() const override;
     void goToSleep() const override;
     unsigned char measureBattery() const override;
-};
\ No newline at end of file
+
+    // Median of the battery level samples (the mean of the two middle ones for an even sample count)
+    template <size_t size>
+    static unsigned char medianBatteryLevel(std::array<float, size> batteryLevels);
+};
+
+template <size_t size>
+unsigned char PowerManagerService::medianBatteryLevel(std::array<float, size> batteryLevels)
+{
+    const unsigned char mid = size / 2;
+    std::nth_element(begin(batteryLevels), begin(batteryLevels) + mid, end(batteryLevels));
+
+    if constexpr (size % 2 != 0)
+    {
+        return lround(batteryLevels[mid]);
+    }
+
+    return lround((batteryLevels[mid] + *std::max_element(cbegin(batteryLevels), cbegin(batteryLevels) + mid)) / 2);
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+// Double buffered snapshot for handing a small value from one writer to readers on other tasks (or cores) without locking. The writer prepares the back buffer in place and publishes it by bumping the sequence, which makes it the front buffer (both buffers are indexed by the parity of the sequence). The back buffer is the one that was the front buffer before the last publish, so the writer may rewrite what a reader is reading as soon as it published once more: readers have to check that the sequence did not change while they were reading and retry if it did, which read() does for them. Values that should be read in place without copying need a TripleBuffer instead
+template <typename T>
+class SeqlockSnapshot
+{
+    std::array<T, 2> buffers{};
+    std::atomic<unsigned int> sequence{0};
+
+public:
+    SeqlockSnapshot() = default;
+    template <typename Initializer>
+    explicit SeqlockSnapshot(Initializer initializer);
+
+    T &back();
+    void publish();
+
+    const T &front() const;
+    T read() const;
+    unsigned int getSequence() const;
+};
+
+template <typename T>
+template <typename Initializer>
+SeqlockSnapshot<T>::SeqlockSnapshot(Initializer initializer)
+{
+    for (auto &buffer : buffers)
+    {
+        initializer(buffer);
+    }
+}
+
+template <typename T>
+T &SeqlockSnapshot<T>::back()
+{
+    // The fence keeps the writes to the back buffer after the publish that handed it back to the writer, so a reader that sees any of them also sees the new sequence
+    std::atomic_thread_fence(std::memory_order_release);
+
+    return buffers[(sequence.load(std::memory_order_relaxed) + 1) & 1U];
+}
+
+template <typename T>
+void SeqlockSnapshot<T>::publish()
+{
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+template <typename T>
+const T &SeqlockSnapshot<T>::front() const
+{
+    // Reading in place is only consistent if getSequence() is the same before and after the read
+    return buffers[sequence.load(std::memory_order_acquire) & 1U];
+}
+
+template <typename T>
+T SeqlockSnapshot<T>::read() const
+{
+    // Returns a consistent copy of the front buffer, retrying if the writer published (and so may have started rewriting the copied buffer) in the meantime
+    auto currentSequence = sequence.load(std::memory_order_acquire);
+    while (true)
+    {
+        T value = buffers[currentSequence & 1U];
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        const auto lastSequence = currentSequence;
+        currentSequence = sequence.load(std::memory_order_acquire);
+        if (currentSequence == lastSequence)
+        {
+            return value;
+        }
+    }
+}
+
+template <typename T>
+unsigned int SeqlockSnapshot<T>::getSequence() const
+{
+    return sequence.load(std::memory_order_acquire);
+}
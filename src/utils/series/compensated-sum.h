@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cmath>
+
+#include "../configuration.h"
+
+// Running sum with Neumaier (improved Kahan) compensation: the low order bits lost when adding a value to a large running sum are collected in a separate term, so long running or windowed sums (where evicted values are subtracted again) do not drift
+class CompensatedSum
+{
+    Configurations::accumulatorPrecision sum = 0;
+    Configurations::accumulatorPrecision compensation = 0;
+
+public:
+    void add(const Configurations::accumulatorPrecision value)
+    {
+        const auto newSum = sum + value;
+        if (std::abs(sum) >= std::abs(value))
+        {
+            compensation += (sum - newSum) + value;
+        }
+        else
+        {
+            compensation += (value - newSum) + sum;
+        }
+        sum = newSum;
+    }
+
+    void subtract(const Configurations::accumulatorPrecision value)
+    {
+        add(-value);
+    }
+
+    constexpr Configurations::accumulatorPrecision value() const
+    {
+        return sum + compensation;
+    }
+
+    constexpr void reset()
+    {
+        sum = 0;
+        compensation = 0;
+    }
+};
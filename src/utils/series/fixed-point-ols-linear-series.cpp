@@ -0,0 +1,78 @@
+#include "./fixed-point-ols-linear-series.h"
+
+void FixedPointOLSLinearSeries::reset()
+{
+    seriesSize = 0;
+    originX = 0;
+    firstY = 0;
+
+    sumX = 0;
+    sumXSquare = 0;
+    sumY = 0;
+    sumYSquare = 0;
+    sumXY = 0;
+}
+
+void FixedPointOLSLinearSeries::push(const long long pointX, const long long pointY)
+{
+    if (seriesSize == 0)
+    {
+        originX = pointX;
+        firstY = pointY;
+    }
+
+    const auto relativeX = pointX - originX;
+
+    sumX += relativeX;
+    sumXSquare += relativeX * relativeX;
+    sumY += pointY;
+    sumYSquare += pointY * pointY;
+    sumXY += relativeX * pointY;
+    ++seriesSize;
+}
+
+long long FixedPointOLSLinearSeries::yAtSeriesBegin() const
+{
+    return firstY;
+}
+
+Configurations::accumulatorPrecision FixedPointOLSLinearSeries::slope() const
+{
+    // Shifting X by the origin leaves the slope unchanged. The products of the sums would overflow 64 bits so the final step is done in double
+    if (seriesSize < 2 || sumX == 0)
+    {
+        return 0.0;
+    }
+
+    const auto size = static_cast<double>(seriesSize);
+    const auto sumXValue = static_cast<double>(sumX);
+
+    return static_cast<Configurations::accumulatorPrecision>((size * static_cast<double>(sumXY) - sumXValue * static_cast<double>(sumY)) / (size * static_cast<double>(sumXSquare) - sumXValue * sumXValue));
+}
+
+Configurations::accumulatorPrecision FixedPointOLSLinearSeries::goodnessOfFit() const
+{
+    // This function returns the R^2 as a goodness of fit indicator
+    if (seriesSize < 2 || sumX == 0)
+    {
+        return 0;
+    }
+
+    const auto size = static_cast<double>(seriesSize);
+    const auto sumXValue = static_cast<double>(sumX);
+    const auto sumYValue = static_cast<double>(sumY);
+    const auto sumXYValue = static_cast<double>(sumXY);
+    const auto sumYSquareValue = static_cast<double>(sumYSquare);
+
+    const auto slope = (size * sumXYValue - sumXValue * sumYValue) / (size * static_cast<double>(sumXSquare) - sumXValue * sumXValue);
+    const auto intercept = (sumYValue - (slope * sumXValue)) / size;
+    const auto sse = sumYSquareValue - (intercept * sumYValue) - (slope * sumXYValue);
+    const auto sst = sumYSquareValue - (sumYValue * sumYValue) / size;
+
+    return static_cast<Configurations::accumulatorPrecision>(1 - (sse / sst));
+}
+
+size_t FixedPointOLSLinearSeries::size() const
+{
+    return seriesSize;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "../configuration.h"
+
+using std::size_t;
+
+// Integer counterpart of the unbounded OLSLinearSeries for the drag factor regression: X (total time) and Y (delta time) are integer microseconds and X is taken relative to the first point, so the sums are exact 64 bit integers (the recovery window is capped by maxDragFactorRecoveryPeriod, see the overflow check in macros.h). Only slope() and goodnessOfFit() use floating point, once per recovery
+class FixedPointOLSLinearSeries
+{
+    size_t seriesSize = 0;
+    long long originX = 0;
+    long long firstY = 0;
+
+    long long sumX = 0;
+    long long sumXSquare = 0;
+    long long sumY = 0;
+    long long sumYSquare = 0;
+    long long sumXY = 0;
+
+public:
+    long long yAtSeriesBegin() const;
+    Configurations::accumulatorPrecision slope() const;
+    Configurations::accumulatorPrecision goodnessOfFit() const;
+    size_t size() const;
+
+    void push(long long pointX, long long pointY);
+    void reset();
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <span>
+
+#include "../configuration.h"
+#include "./median-network.h"
+
+using std::size_t;
+using std::span;
+
+// Compile time sized counterpart of Series for windows whose length is known at compile time (e.g. Configurations::impulseDataArrayLength). Values (floating point or fixed point integers) are kept in a ring buffer on an std::array so the series never touches the heap. Every value is written twice (at its slot and at slot + maxSeriesLength) so the window is always one contiguous range that can be handed to the vectorisable kernels
+template <unsigned char maxSeriesLength, typename T = Configurations::precision>
+class FixedSeries
+{
+    static_assert(maxSeriesLength > 0, "FixedSeries requires a non-zero length, use Series for unbounded series");
+
+    T seriesSum = 0;
+    unsigned char head = 0;
+    unsigned char seriesSize = 0;
+    std::array<T, maxSeriesLength * 2> seriesArray{};
+
+public:
+    const T &operator[](size_t index) const;
+    span<const T> values() const;
+
+    size_t size() const;
+    static constexpr size_t capacity();
+    Configurations::accumulatorPrecision average() const;
+    T median() const;
+    T sum() const;
+
+    void push(T value);
+    void shift(T offset);
+    void reset();
+};
+
+template <unsigned char maxSeriesLength, typename T>
+const T &FixedSeries<maxSeriesLength, T>::operator[](size_t index) const
+{
+    return seriesArray[head + index];
+}
+
+template <unsigned char maxSeriesLength, typename T>
+span<const T> FixedSeries<maxSeriesLength, T>::values() const
+{
+    return span<const T>(seriesArray.data() + head, seriesSize);
+}
+
+template <unsigned char maxSeriesLength, typename T>
+size_t FixedSeries<maxSeriesLength, T>::size() const
+{
+    return seriesSize;
+}
+
+template <unsigned char maxSeriesLength, typename T>
+constexpr size_t FixedSeries<maxSeriesLength, T>::capacity()
+{
+    return maxSeriesLength;
+}
+
+template <unsigned char maxSeriesLength, typename T>
+Configurations::accumulatorPrecision FixedSeries<maxSeriesLength, T>::average() const
+{
+    if (seriesSize == 0)
+    {
+        return 0.0;
+    }
+
+    return seriesSum / (Configurations::accumulatorPrecision)seriesSize;
+}
+
+template <unsigned char maxSeriesLength, typename T>
+T FixedSeries<maxSeriesLength, T>::median() const
+{
+    if (seriesSize == 0)
+    {
+        return 0;
+    }
+
+    // The selection network reorders its input so it works on a copy of the window (which is contiguous from the head)
+    std::array<T, maxSeriesLength> selection{};
+    std::copy(cbegin(seriesArray) + head, cbegin(seriesArray) + head + seriesSize, begin(selection));
+    if (seriesSize == maxSeriesLength)
+    {
+        return MedianNetwork::select<maxSeriesLength>(selection.data());
+    }
+
+    return MedianNetwork::select(span<T>(selection.data(), seriesSize));
+}
+
+template <unsigned char maxSeriesLength, typename T>
+T FixedSeries<maxSeriesLength, T>::sum() const
+{
+    return seriesSum;
+}
+
+template <unsigned char maxSeriesLength, typename T>
+void FixedSeries<maxSeriesLength, T>::push(const T value)
+{
+    if (seriesSize < maxSeriesLength)
+    {
+        seriesArray[seriesSize] = value;
+        seriesArray[seriesSize + maxSeriesLength] = value;
+        ++seriesSize;
+        seriesSum += value;
+
+        return;
+    }
+
+    // The maximum of the array has been reached, the oldest value (at the head) is replaced by the new one and the head moves to the next oldest value
+    seriesSum -= seriesArray[head];
+    seriesArray[head] = value;
+    seriesArray[head + maxSeriesLength] = value;
+    seriesSum += value;
+    ++head;
+    if (head == maxSeriesLength)
+    {
+        head = 0;
+    }
+}
+
+template <unsigned char maxSeriesLength, typename T>
+void FixedSeries<maxSeriesLength, T>::shift(const T offset)
+{
+    // Subtracts the offset from every value (e.g. to move the coordinates of a regression window to a new origin). Until the series fills up the used slots are the first seriesSize ones, after that all of them
+    for (unsigned char i = 0; i < seriesSize; ++i)
+    {
+        seriesArray[i] -= offset;
+        seriesArray[i + maxSeriesLength] -= offset;
+    }
+    seriesSum -= offset * seriesSize;
+}
+
+template <unsigned char maxSeriesLength, typename T>
+void FixedSeries<maxSeriesLength, T>::reset()
+{
+    head = 0;
+    seriesSize = 0;
+    seriesSum = 0;
+}
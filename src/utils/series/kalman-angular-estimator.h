@@ -0,0 +1,199 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+
+#include "../configuration.h"
+#include "./fixed-series.h"
+
+// Constant time alternative to the quadratic regression angular estimators: a constant jerk Kalman filter over the state [angular displacement, angular velocity, angular acceleration, jerk] that is driven by the (total time, angular displacement) point of every impulse. The process noise is white noise on the change of the jerk (with the given spectral density) and the measurement noise is the standard deviation of the angular displacement of an impulse (e.g. magnet placement errors). Every push costs the same regardless of the window length, the window is only used to read the estimates at its oldest point (the state is propagated back to the time of that point) so they have the same lag as those of the regression estimators and the delta time regression
+template <unsigned char windowLength, typename T = Configurations::accumulatorPrecision>
+class KalmanAngularEstimator
+{
+    static_assert(windowLength > 0, "KalmanAngularEstimator requires a non-zero window length");
+
+    static constexpr unsigned char stateSize = 4;
+    // Initial standard deviation of the velocity, acceleration and jerk, large enough for the first measurements to determine them
+    static constexpr std::array<T, stateSize> initialDeviations = {0, 1e3, 1e5, 1e7};
+
+    T processNoise = 0;
+    T measurementVariance = 0;
+
+    std::array<T, stateSize> state{};
+    std::array<std::array<T, stateSize>, stateSize> covariance{};
+    T lastConfidence = 0;
+    bool isInitialised = false;
+    FixedSeries<windowLength, T> seriesX;
+
+    void initialise(T pointX, T pointY);
+    void predict(T deltaX);
+    void update(T pointY);
+    T windowLag() const;
+
+public:
+    KalmanAngularEstimator(T _processNoise, T measurementNoise);
+
+    T angularVelocity() const;
+    T angularAcceleration() const;
+    T confidence() const;
+
+    void push(T pointX, T pointY);
+    void reset();
+};
+
+template <unsigned char windowLength, typename T>
+KalmanAngularEstimator<windowLength, T>::KalmanAngularEstimator(const T _processNoise, const T measurementNoise) : processNoise(_processNoise), measurementVariance(measurementNoise * measurementNoise)
+{
+    push(0, 0);
+}
+
+template <unsigned char windowLength, typename T>
+void KalmanAngularEstimator<windowLength, T>::initialise(const T pointX, const T pointY)
+{
+    state = {pointY, 0, 0, 0};
+    covariance = {};
+    covariance[0][0] = measurementVariance;
+    for (unsigned char i = 1; i < stateSize; ++i)
+    {
+        covariance[i][i] = initialDeviations[i] * initialDeviations[i];
+    }
+
+    lastConfidence = 1;
+    isInitialised = true;
+    seriesX.push(pointX);
+}
+
+template <unsigned char windowLength, typename T>
+void KalmanAngularEstimator<windowLength, T>::predict(const T deltaX)
+{
+    // Transition of the constant jerk model: row i holds deltaX^(j - i) / (j - i)!
+    const T deltaX2 = deltaX * deltaX / 2;
+    const T deltaX3 = deltaX2 * deltaX / 3;
+    const std::array<std::array<T, stateSize>, stateSize> transition = {{
+        {1, deltaX, deltaX2, deltaX3},
+        {0, 1, deltaX, deltaX2},
+        {0, 0, 1, deltaX},
+        {0, 0, 0, 1},
+    }};
+
+    std::array<T, stateSize> newState{};
+    std::array<std::array<T, stateSize>, stateSize> transitionCovariance{};
+    for (unsigned char i = 0; i < stateSize; ++i)
+    {
+        for (unsigned char k = i; k < stateSize; ++k)
+        {
+            newState[i] += transition[i][k] * state[k];
+            for (unsigned char j = 0; j < stateSize; ++j)
+            {
+                transitionCovariance[i][j] += transition[i][k] * covariance[k][j];
+            }
+        }
+    }
+    state = newState;
+
+    // The process noise of white noise on the change of the jerk integrated over the step: q * deltaX^(7 - i - j) / ((3 - i)! * (3 - j)! * (7 - i - j))
+    constexpr std::array<T, stateSize> factorials = {6, 2, 1, 1};
+    for (unsigned char i = 0; i < stateSize; ++i)
+    {
+        for (unsigned char j = i; j < stateSize; ++j)
+        {
+            T value = 0;
+            for (unsigned char k = j; k < stateSize; ++k)
+            {
+                value += transitionCovariance[i][k] * transition[j][k];
+            }
+
+            const unsigned char power = 7 - i - j;
+            value += processNoise * std::pow(deltaX, power) / (factorials[i] * factorials[j] * power);
+
+            covariance[i][j] = value;
+            covariance[j][i] = value;
+        }
+    }
+}
+
+template <unsigned char windowLength, typename T>
+void KalmanAngularEstimator<windowLength, T>::update(const T pointY)
+{
+    const T innovation = pointY - state[0];
+    const T innovationVariance = covariance[0][0] + measurementVariance;
+
+    std::array<T, stateSize> gain{};
+    for (unsigned char i = 0; i < stateSize; ++i)
+    {
+        gain[i] = covariance[i][0] / innovationVariance;
+        state[i] += gain[i] * innovation;
+    }
+
+    const auto firstRow = covariance[0];
+    for (unsigned char i = 0; i < stateSize; ++i)
+    {
+        for (unsigned char j = i; j < stateSize; ++j)
+        {
+            covariance[i][j] -= gain[i] * firstRow[j];
+            covariance[j][i] = covariance[i][j];
+        }
+    }
+
+    // The confidence is the likelihood of the measurement relative to the prediction (1 for a measurement exactly as predicted, falling towards zero as the normalised innovation grows)
+    lastConfidence = std::exp(-innovation * innovation / (2 * innovationVariance));
+}
+
+template <unsigned char windowLength, typename T>
+T KalmanAngularEstimator<windowLength, T>::windowLag() const
+{
+    // Time from the newest point back to the oldest point of the window (zero or negative)
+    if (seriesX.size() == 0)
+    {
+        return 0;
+    }
+
+    return seriesX[0] - seriesX[seriesX.size() - 1];
+}
+
+template <unsigned char windowLength, typename T>
+T KalmanAngularEstimator<windowLength, T>::angularVelocity() const
+{
+    const T deltaX = windowLag();
+
+    return state[1] + state[2] * deltaX + state[3] * deltaX * deltaX / 2;
+}
+
+template <unsigned char windowLength, typename T>
+T KalmanAngularEstimator<windowLength, T>::angularAcceleration() const
+{
+    const T deltaX = windowLag();
+
+    return state[2] + state[3] * deltaX;
+}
+
+template <unsigned char windowLength, typename T>
+T KalmanAngularEstimator<windowLength, T>::confidence() const
+{
+    return lastConfidence;
+}
+
+template <unsigned char windowLength, typename T>
+void KalmanAngularEstimator<windowLength, T>::push(const T pointX, const T pointY)
+{
+    if (!isInitialised)
+    {
+        initialise(pointX, pointY);
+
+        return;
+    }
+
+    predict(pointX - seriesX[seriesX.size() - 1]);
+    update(pointY);
+    seriesX.push(pointX);
+}
+
+template <unsigned char windowLength, typename T>
+void KalmanAngularEstimator<windowLength, T>::reset()
+{
+    state = {};
+    covariance = {};
+    lastConfidence = 0;
+    isInitialised = false;
+    seriesX.reset();
+}
\ No newline at end of file
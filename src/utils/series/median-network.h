@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <utility>
+
+using std::size_t;
+using std::span;
+
+// Branch-free median selection for the small, fixed size sets of the regressions (e.g. the 21 pairwise slopes or the 35 triples of a window of 7). The selection networks are generated at compile time from Batcher's odd-even merge sort (padded to the next power of two, where comparators that touch the padding are dropped as the padding never moves) and pruned to the comparators the middle outputs depend on. Applying a comparator is a min and a max, so the selection has no data dependent branches, which suits the in-order pipeline of the ESP32 better than nth_element (plus max_element for even sizes). Sizes above maxNetworkSize fall back to nth_element as the network grows with n log^2 n
+namespace MedianNetwork
+{
+    inline constexpr unsigned short maxNetworkSize = 64;
+
+    struct Comparator
+    {
+        unsigned char low = 0;
+        unsigned char high = 0;
+    };
+
+    constexpr unsigned short paddedSize(const unsigned short size)
+    {
+        unsigned short padded = 1;
+        while (padded < size)
+        {
+            padded *= 2;
+        }
+
+        return padded;
+    }
+
+    // Number of comparators of the odd-even merge sort of 2^p elements: (p^2 - p + 4) * 2^(p - 2) - 1, which bounds the pruned network
+    constexpr unsigned short batcherComparatorCount(const unsigned short size)
+    {
+        unsigned short power = 0;
+        while ((1U << power) < paddedSize(size))
+        {
+            ++power;
+        }
+
+        return power < 2 ? power : (power * power - power + 4) * (1U << (power - 2)) - 1;
+    }
+
+    template <unsigned short size>
+    struct Network
+    {
+        static_assert(size > 0 && size <= maxNetworkSize, "MedianNetwork is only generated up to maxNetworkSize elements");
+
+    private:
+        struct GeneratedNetwork
+        {
+            std::array<Comparator, batcherComparatorCount(size)> comparators{};
+            unsigned short count = 0;
+        };
+
+        static constexpr GeneratedNetwork generate()
+        {
+            GeneratedNetwork sortingNetwork;
+            const unsigned short padded = paddedSize(size);
+            for (unsigned short p = 1; p < padded; p *= 2)
+            {
+                for (unsigned short k = p; k >= 1; k /= 2)
+                {
+                    for (unsigned short j = k % p; j + k < padded; j += 2 * k)
+                    {
+                        for (unsigned short i = 0; i < std::min<unsigned short>(k, padded - j - k); ++i)
+                        {
+                            const unsigned short low = i + j;
+                            const unsigned short high = i + j + k;
+                            if (low / (2 * p) == high / (2 * p) && high < size)
+                            {
+                                sortingNetwork.comparators[sortingNetwork.count++] = {static_cast<unsigned char>(low), static_cast<unsigned char>(high)};
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Walking the sorting network backwards from the middle outputs, a comparator is only needed if one of its outputs is needed, and then both of its inputs are
+            std::array<bool, size> isNeeded{};
+            isNeeded[size / 2] = true;
+            if (size % 2 == 0)
+            {
+                isNeeded[size / 2 - 1] = true;
+            }
+
+            GeneratedNetwork selectionNetwork;
+            std::array<bool, batcherComparatorCount(size)> isKept{};
+            for (unsigned short i = sortingNetwork.count; i-- > 0;)
+            {
+                const auto comparator = sortingNetwork.comparators[i];
+                if (isNeeded[comparator.low] || isNeeded[comparator.high])
+                {
+                    isNeeded[comparator.low] = true;
+                    isNeeded[comparator.high] = true;
+                    isKept[i] = true;
+                }
+            }
+            for (unsigned short i = 0; i < sortingNetwork.count; ++i)
+            {
+                if (isKept[i])
+                {
+                    selectionNetwork.comparators[selectionNetwork.count++] = sortingNetwork.comparators[i];
+                }
+            }
+
+            return selectionNetwork;
+        }
+
+        static constexpr GeneratedNetwork generated = generate();
+
+    public:
+        static constexpr std::array<Comparator, generated.count> comparators = []()
+        {
+            std::array<Comparator, generated.count> compacted{};
+            std::copy(generated.comparators.begin(), generated.comparators.begin() + generated.count, compacted.begin());
+
+            return compacted;
+        }();
+    };
+
+    // Reorders the values so the middle one(s) end up at size / 2 (and size / 2 - 1), the average of the two middle values is returned for even sizes
+    template <unsigned short size, typename T>
+    T select(T *const values)
+    {
+        if constexpr (size > maxNetworkSize)
+        {
+            constexpr unsigned short mid = size / 2;
+            std::nth_element(values, values + mid, values + size);
+            if constexpr (size % 2 != 0)
+            {
+                return values[mid];
+            }
+
+            return (values[mid] + *std::max_element(values, values + mid)) / 2;
+        }
+        else
+        {
+            for (const auto comparator : Network<size>::comparators)
+            {
+                const T low = values[comparator.low];
+                const T high = values[comparator.high];
+                values[comparator.low] = std::min(low, high);
+                values[comparator.high] = std::max(low, high);
+            }
+
+            if constexpr (size % 2 != 0)
+            {
+                return values[size / 2];
+            }
+
+            return (values[size / 2 - 1] + values[size / 2]) / 2;
+        }
+    }
+
+    // Median of a set whose size is only known at run time (e.g. while a window fills up): the network of that size is looked up from a table generated for every size up to maxNetworkSize
+    template <typename T>
+    T select(const span<T> values)
+    {
+        static constexpr auto networks = []<size_t... sizes>(std::index_sequence<sizes...>)
+        {
+            return std::array<T (*)(T *), maxNetworkSize + 1>{nullptr, &select<sizes + 1, T>...};
+        }(std::make_index_sequence<maxNetworkSize>{});
+
+        const auto size = values.size();
+        if (size == 0)
+        {
+            return 0;
+        }
+
+        if (size <= maxNetworkSize)
+        {
+            return networks[size](values.data());
+        }
+
+        const auto mid = size / 2;
+        std::nth_element(values.begin(), values.begin() + mid, values.end());
+        if (size % 2 != 0)
+        {
+            return values[mid];
+        }
+
+        return (values[mid] + *std::max_element(values.begin(), values.begin() + mid)) / 2;
+    }
+}
\ No newline at end of file
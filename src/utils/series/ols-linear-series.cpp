@@ -2,53 +2,148 @@
 
 void OLSLinearSeries::reset()
 {
-    seriesX.reset();
-    seriesXSquare.reset();
-    seriesY.reset();
-    seriesYSquare.reset();
-    seriesXY.reset();
+    points.clear();
+    head = 0;
+    seriesSize = 0;
+    firstY = 0;
+    originX = 0;
+
+    sumX.reset();
+    sumXSquare.reset();
+    sumY.reset();
+    sumYSquare.reset();
+    sumXY.reset();
+}
+
+void OLSLinearSeries::addToSums(const Configurations::accumulatorPrecision pointX, const Configurations::accumulatorPrecision pointY)
+{
+    sumX.add(pointX);
+    sumXSquare.add(pointX * pointX);
+    sumY.add(pointY);
+    sumYSquare.add(pointY * pointY);
+    sumXY.add(pointX * pointY);
+}
+
+void OLSLinearSeries::subtractFromSums(const Configurations::accumulatorPrecision pointX, const Configurations::accumulatorPrecision pointY)
+{
+    sumX.subtract(pointX);
+    sumXSquare.subtract(pointX * pointX);
+    sumY.subtract(pointY);
+    sumYSquare.subtract(pointY * pointY);
+    sumXY.subtract(pointX * pointY);
+}
+
+void OLSLinearSeries::rebase()
+{
+    const auto offset = points[head].x;
+    originX += offset;
+
+    sumX.reset();
+    sumXSquare.reset();
+    sumY.reset();
+    sumYSquare.reset();
+    sumXY.reset();
+    for (auto &point : points)
+    {
+        point.x -= offset;
+        addToSums(point.x, point.y);
+    }
 }
 
-void OLSLinearSeries::push(const Configurations::precision pointX, const Configurations::precision pointY)
+void OLSLinearSeries::push(const Configurations::accumulatorPrecision pointX, const Configurations::accumulatorPrecision pointY)
 {
-    seriesX.push(pointX);
-    seriesXSquare.push(pointX * pointX);
-    seriesY.push(pointY);
-    seriesYSquare.push(pointY * pointY);
-    seriesXY.push(pointX * pointY);
+    if (seriesSize == 0)
+    {
+        firstY = pointY;
+        originX = pointX;
+    }
+
+    const auto x = pointX - originX;
+    addToSums(x, pointY);
+
+    if (maxSeriesLength == 0)
+    {
+        ++seriesSize;
+
+        return;
+    }
+
+    if (seriesSize < maxSeriesLength)
+    {
+        points.push_back({x, pointY});
+        ++seriesSize;
+
+        return;
+    }
+
+    // The maximum of the window has been reached, the oldest point (at the head) is subtracted from the sums and replaced by the new one
+    subtractFromSums(points[head].x, points[head].y);
+    points[head] = {x, pointY};
+    ++head;
+    if (head == maxSeriesLength)
+    {
+        head = 0;
+        rebase();
+    }
 }
 
-Configurations::precision OLSLinearSeries::yAtSeriesBegin() const
+Configurations::accumulatorPrecision OLSLinearSeries::yAtSeriesBegin() const
 {
-    return seriesY[0];
+    if (maxSeriesLength == 0 || points.empty())
+    {
+        return firstY;
+    }
+
+    return points[head].y;
 }
 
-Configurations::precision OLSLinearSeries::slope() const
+Configurations::accumulatorPrecision OLSLinearSeries::slope() const
 {
-    if (seriesX.size() < 2 || seriesX.sum() == 0)
+    // X is relative to the origin so the sum of X may be zero, the regression is only undefined if all X are the same (i.e. the denominator is zero)
+    if (seriesSize < 2)
     {
         return 0.0;
     }
 
-    return ((Configurations::precision)seriesX.size() * seriesXY.sum() - seriesX.sum() * seriesY.sum()) / ((Configurations::precision)seriesX.size() * seriesXSquare.sum() - seriesX.sum() * seriesX.sum());
+    const auto sumXValue = sumX.value();
+    const auto size = (Configurations::accumulatorPrecision)seriesSize;
+    const auto denominator = size * sumXSquare.value() - sumXValue * sumXValue;
+    if (denominator == 0)
+    {
+        return 0.0;
+    }
+
+    return (size * sumXY.value() - sumXValue * sumY.value()) / denominator;
 }
 
-Configurations::precision OLSLinearSeries::goodnessOfFit() const
+Configurations::accumulatorPrecision OLSLinearSeries::goodnessOfFit() const
 {
     // This function returns the R^2 as a goodness of fit indicator
-    if (seriesX.size() < 2 || seriesX.sum() == 0)
+    if (seriesSize < 2)
+    {
+        return 0;
+    }
+
+    const auto sumXValue = sumX.value();
+    const auto size = (Configurations::accumulatorPrecision)seriesSize;
+    const auto denominator = size * sumXSquare.value() - sumXValue * sumXValue;
+    if (denominator == 0)
     {
         return 0;
     }
 
-    const auto slope = ((Configurations::precision)seriesX.size() * seriesXY.sum() - seriesX.sum() * seriesY.sum()) / ((Configurations::precision)seriesX.size() * seriesXSquare.sum() - seriesX.sum() * seriesX.sum());
-    const auto intercept = (seriesY.sum() - (slope * seriesX.sum())) / (Configurations::precision)seriesX.size();
-    const auto sse = seriesYSquare.sum() - (intercept * seriesY.sum()) - (slope * seriesXY.sum());
-    const auto sst = seriesYSquare.sum() - (seriesY.sum() * seriesY.sum()) / (Configurations::precision)seriesX.size();
+    const auto sumYValue = sumY.value();
+    const auto sumXYValue = sumXY.value();
+    const auto sumYSquareValue = sumYSquare.value();
+
+    const auto slope = (size * sumXYValue - sumXValue * sumYValue) / denominator;
+    const auto intercept = (sumYValue - (slope * sumXValue)) / size;
+    const auto sse = sumYSquareValue - (intercept * sumYValue) - (slope * sumXYValue);
+    const auto sst = sumYSquareValue - (sumYValue * sumYValue) / size;
     return 1 - (sse / sst);
 }
 
 size_t OLSLinearSeries::size() const
 {
-    return seriesY.size();
-}
\ No newline at end of file
+    return seriesSize;
+}
@@ -1,24 +1,50 @@
 #pragma once
 
+#include <vector>
+
 #include "../configuration.h"
-#include "./series.h"
+#include "./compensated-sum.h"
+
+using std::size_t;
 
 class OLSLinearSeries
 {
-    Series seriesX;
-    Series seriesXSquare;
-    Series seriesY;
-    Series seriesYSquare;
-    Series seriesXY;
+    struct Point
+    {
+        Configurations::accumulatorPrecision x;
+        Configurations::accumulatorPrecision y;
+    };
+
+    // The regression only needs the sums of the series. A length limited series keeps its points in a ring so the evicted point can be subtracted from the sums, an unbounded series keeps no points at all (only the first Y for yAtSeriesBegin)
+    unsigned char maxSeriesLength;
+    unsigned char head = 0;
+    size_t seriesSize = 0;
+    Configurations::accumulatorPrecision firstY = 0;
+    // X is taken relative to an origin so the squared total time does not swamp the sums: an unbounded series uses its first point, a length limited one moves the origin to its oldest point (and recalculates the sums) every time the ring wraps around
+    Configurations::accumulatorPrecision originX = 0;
+    std::vector<Point> points;
+
+    CompensatedSum sumX;
+    CompensatedSum sumXSquare;
+    CompensatedSum sumY;
+    CompensatedSum sumYSquare;
+    CompensatedSum sumXY;
+
+    void addToSums(Configurations::accumulatorPrecision pointX, Configurations::accumulatorPrecision pointY);
+    void subtractFromSums(Configurations::accumulatorPrecision pointX, Configurations::accumulatorPrecision pointY);
+    void rebase();
 
 public:
-    constexpr explicit OLSLinearSeries(const unsigned char _maxSeriesLength = 0, const unsigned short _maxAllocationCapacity = 1'000) : seriesX(_maxSeriesLength, _maxAllocationCapacity), seriesXSquare(_maxSeriesLength, _maxAllocationCapacity), seriesY(_maxSeriesLength, _maxAllocationCapacity), seriesYSquare(_maxSeriesLength, _maxAllocationCapacity), seriesXY(_maxSeriesLength, _maxAllocationCapacity) {}
+    constexpr explicit OLSLinearSeries(const unsigned char _maxSeriesLength = 0) : maxSeriesLength(_maxSeriesLength)
+    {
+        points.reserve(_maxSeriesLength);
+    }
 
-    Configurations::precision yAtSeriesBegin() const;
-    Configurations::precision slope() const;
-    Configurations::precision goodnessOfFit() const;
+    Configurations::accumulatorPrecision yAtSeriesBegin() const;
+    Configurations::accumulatorPrecision slope() const;
+    Configurations::accumulatorPrecision goodnessOfFit() const;
     size_t size() const;
 
-    void push(Configurations::precision pointX, Configurations::precision pointY);
+    void push(Configurations::accumulatorPrecision pointX, Configurations::accumulatorPrecision pointY);
     void reset();
-};
\ No newline at end of file
+};
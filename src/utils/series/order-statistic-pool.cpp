@@ -0,0 +1,263 @@
+#include <algorithm>
+
+#include "./order-statistic-pool.h"
+
+template <typename T>
+unsigned short OrderStatisticPool<T>::allocateBlock()
+{
+    if (!freeBlocks.empty())
+    {
+        const auto blockIndex = freeBlocks.back();
+        freeBlocks.pop_back();
+        blocks[blockIndex].size = 0;
+
+        return blockIndex;
+    }
+
+    blocks.emplace_back();
+
+    return static_cast<unsigned short>(blocks.size() - 1);
+}
+
+template <typename T>
+void OrderStatisticPool<T>::releaseBlock(const unsigned short orderIndex)
+{
+    freeBlocks.push_back(order[orderIndex]);
+    order.erase(begin(order) + orderIndex);
+}
+
+template <typename T>
+void OrderStatisticPool<T>::mergeBlocks(const unsigned short orderIndex)
+{
+    // Appends the next block to the block at orderIndex (all of its values are not less than the values of this block)
+    auto &block = blocks[order[orderIndex]];
+    const auto &nextBlock = blocks[order[orderIndex + 1]];
+    std::copy(cbegin(nextBlock.values), cbegin(nextBlock.values) + nextBlock.size, begin(block.values) + block.size);
+    block.size += nextBlock.size;
+    releaseBlock(orderIndex + 1);
+}
+
+template <typename T>
+void OrderStatisticPool<T>::rebuildBlockSizeTree()
+{
+    const auto blockCount = order.size();
+    blockSizeTree.assign(blockCount + 1, 0);
+    for (size_t i = 1; i <= blockCount; ++i)
+    {
+        blockSizeTree[i] += blocks[order[i - 1]].size;
+        const auto parent = i + (i & (~i + 1));
+        if (parent <= blockCount)
+        {
+            blockSizeTree[parent] += blockSizeTree[i];
+        }
+    }
+
+    blockSizeTreeStep = 1;
+    while (blockSizeTreeStep * 2U <= blockCount)
+    {
+        blockSizeTreeStep *= 2;
+    }
+}
+
+template <typename T>
+void OrderStatisticPool<T>::updateBlockSizeTree(const unsigned short orderIndex, const int change)
+{
+    for (size_t i = orderIndex + 1U; i < blockSizeTree.size(); i += i & (~i + 1))
+    {
+        blockSizeTree[i] += change;
+    }
+}
+
+template <typename T>
+unsigned short OrderStatisticPool<T>::findBlock(const T value) const
+{
+    // Binary search for the first block whose largest value is not less than the searched value (or the last block if there is none)
+    unsigned short low = 0;
+    auto high = static_cast<unsigned short>(order.size() - 1);
+    while (low < high)
+    {
+        const unsigned short mid = (low + high) / 2;
+        const auto &block = blocks[order[mid]];
+        if (block.values[block.size - 1] < value)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+template <typename T>
+size_t OrderStatisticPool<T>::size() const
+{
+    return count;
+}
+
+template <typename T>
+T OrderStatisticPool<T>::kth(size_t index) const
+{
+    if (index >= count)
+    {
+        return 0;
+    }
+
+    // Descends the Fenwick tree to the last block whose preceding blocks hold no more than index values
+    size_t position = 0;
+    for (size_t step = blockSizeTreeStep; step > 0; step /= 2)
+    {
+        const auto next = position + step;
+        if (next < blockSizeTree.size() && blockSizeTree[next] <= index)
+        {
+            position = next;
+            index -= blockSizeTree[next];
+        }
+    }
+
+    return blocks[order[position]].values[index];
+}
+
+template <typename T>
+T OrderStatisticPool<T>::median() const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    const auto mid = count / 2;
+
+    if (count % 2 != 0)
+    {
+        return kth(mid);
+    }
+
+    return (kth(mid) + kth(mid - 1)) / 2;
+}
+
+template <typename T>
+void OrderStatisticPool<T>::insert(const T value)
+{
+    auto isRestructured = false;
+    if (order.empty())
+    {
+        order.push_back(allocateBlock());
+        isRestructured = true;
+    }
+
+    auto orderIndex = findBlock(value);
+    auto blockIndex = order[orderIndex];
+
+    if (blocks[blockIndex].size == blockCapacity)
+    {
+        // The block is full, so move its upper half to a new block placed right after it
+        const auto newBlockIndex = allocateBlock();
+        auto &block = blocks[blockIndex];
+        auto &newBlock = blocks[newBlockIndex];
+        const unsigned char half = blockCapacity / 2;
+
+        std::copy(cbegin(block.values) + half, cend(block.values), begin(newBlock.values));
+        newBlock.size = blockCapacity - half;
+        block.size = half;
+        order.insert(begin(order) + orderIndex + 1, newBlockIndex);
+        isRestructured = true;
+
+        if (block.values[half - 1] < value)
+        {
+            blockIndex = newBlockIndex;
+            ++orderIndex;
+        }
+    }
+
+    auto &block = blocks[blockIndex];
+    const auto blockEnd = begin(block.values) + block.size;
+    const auto position = std::upper_bound(begin(block.values), blockEnd, value);
+    std::copy_backward(position, blockEnd, blockEnd + 1);
+    *position = value;
+    ++block.size;
+    ++count;
+
+    if (isRestructured)
+    {
+        rebuildBlockSizeTree();
+
+        return;
+    }
+
+    updateBlockSizeTree(orderIndex, 1);
+}
+
+template <typename T>
+bool OrderStatisticPool<T>::erase(const T value)
+{
+    if (count == 0)
+    {
+        return false;
+    }
+
+    const auto orderIndex = findBlock(value);
+    auto &block = blocks[order[orderIndex]];
+    const auto blockEnd = begin(block.values) + block.size;
+    const auto position = std::lower_bound(begin(block.values), blockEnd, value);
+
+    if (position == blockEnd || *position != value)
+    {
+        return false;
+    }
+
+    std::copy(position + 1, blockEnd, position);
+    --block.size;
+    --count;
+
+    if (block.size == 0)
+    {
+        releaseBlock(orderIndex);
+        rebuildBlockSizeTree();
+
+        return true;
+    }
+
+    // Merge with a sparse neighbour on either side so any two neighbouring blocks keep more than half a block of values, which bounds the number of blocks the pool reserved for
+    auto isRestructured = false;
+    auto mergedIndex = orderIndex;
+    if (mergedIndex > 0 && blocks[order[mergedIndex - 1]].size + blocks[order[mergedIndex]].size <= blockCapacity / 2)
+    {
+        --mergedIndex;
+        mergeBlocks(mergedIndex);
+        isRestructured = true;
+    }
+    if (mergedIndex + 1U < order.size() && blocks[order[mergedIndex]].size + blocks[order[mergedIndex + 1]].size <= blockCapacity / 2)
+    {
+        mergeBlocks(mergedIndex);
+        isRestructured = true;
+    }
+
+    if (isRestructured)
+    {
+        rebuildBlockSizeTree();
+
+        return true;
+    }
+
+    updateBlockSizeTree(orderIndex, -1);
+
+    return true;
+}
+
+template <typename T>
+void OrderStatisticPool<T>::reset()
+{
+    blocks.clear();
+    freeBlocks.clear();
+    order.clear();
+    blockSizeTree.clear();
+    blockSizeTreeStep = 0;
+    count = 0;
+}
+
+template class OrderStatisticPool<float>;
+template class OrderStatisticPool<double>;
+template class OrderStatisticPool<long long>;
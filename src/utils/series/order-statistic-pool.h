@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "../configuration.h"
+
+using std::size_t;
+
+// Sorted multiset (of floating point or fixed point integer values) split into small fixed size blocks (i.e. a two level B-tree) so insert/erase only shift values within a single block. The block sizes are indexed by a Fenwick tree so the block of the k-th smallest value is found in O(log blocks) (the tree is only rebuilt when blocks are split, merged or released, which already shifts the block order). Blocks are kept in a pool reserved upfront and reused via a free list, so once warmed up insert and erase do not touch the heap
+template <typename T>
+class OrderStatisticPool
+{
+    static constexpr unsigned char blockCapacity = 32;
+
+    struct Block
+    {
+        unsigned char size = 0;
+        std::array<T, blockCapacity> values;
+    };
+
+    size_t count = 0;
+    std::vector<Block> blocks;
+    std::vector<unsigned short> freeBlocks;
+    std::vector<unsigned short> order;
+    std::vector<unsigned int> blockSizeTree;
+    unsigned short blockSizeTreeStep = 0;
+
+    unsigned short allocateBlock();
+    void releaseBlock(unsigned short orderIndex);
+    void mergeBlocks(unsigned short orderIndex);
+    unsigned short findBlock(T value) const;
+    void rebuildBlockSizeTree();
+    void updateBlockSizeTree(unsigned short orderIndex, int change);
+
+public:
+    constexpr explicit OrderStatisticPool(const unsigned short _maxSize = 0)
+    {
+        // Any two neighbouring blocks hold more than half a block of values combined (erase merges a block with either neighbour otherwise, and a split leaves two half full blocks), so n values never occupy more than 2n / (blockCapacity / 2 + 1) + 1 blocks (plus one for the block split before the value is inserted)
+        const auto maxBlockCount = (_maxSize * 2U) / (blockCapacity / 2U + 1U) + 2U;
+        blocks.reserve(maxBlockCount);
+        freeBlocks.reserve(maxBlockCount);
+        order.reserve(maxBlockCount);
+        blockSizeTree.reserve(maxBlockCount + 1U);
+    }
+
+    size_t size() const;
+    T kth(size_t index) const;
+    T median() const;
+
+    void insert(T value);
+    bool erase(T value);
+    void reset();
+};
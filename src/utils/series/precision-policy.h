@@ -0,0 +1,9 @@
+#pragma once
+
+// Precision policy of the regression series. TStorage is the type of the pairwise slopes and triple coefficients that are kept in the rings and ordered for the median selection (these make up the bulk of the memory and comparisons, so float here gives most of the float speed), TCompute is the type of the points and of the arithmetic on them (the total time and angular displacement keep growing during a session, so these lose the most in float)
+template <typename TStorage, typename TCompute = TStorage>
+struct PrecisionPolicy
+{
+    typedef TStorage storage;
+    typedef TCompute compute;
+};
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <span>
+
+using std::size_t;
+using std::span;
+
+// Running moment sums (of x, x^2, x^3, x^4, y, xy, x^2y, y^2) of a sliding window of points, so the R^2 of a quadratic fit can be calculated in O(1). The sums are taken relative to an origin (the first point added, then the oldest point of the window when last rebased) to avoid the cancellation of the high powers of the session long total time and angular displacement, and are recalculated from the window once every maxSeriesLength pushes so the added and removed terms do not drift
+template <unsigned char maxSeriesLength, typename T>
+class QuadraticMomentSums
+{
+    T originX = 0;
+    T originY = 0;
+    unsigned char pushesSinceRebase = 0;
+    size_t count = 0;
+
+    T sumX = 0;
+    T sumXSquare = 0;
+    T sumXCube = 0;
+    T sumXFourth = 0;
+    T sumY = 0;
+    T sumXY = 0;
+    T sumXSquareY = 0;
+    T sumYSquare = 0;
+
+    void accumulate(T pointX, T pointY, T sign);
+
+public:
+    bool isRebaseDue() const;
+    T goodnessOfFit(T a, T b, T c) const;
+
+    void add(T pointX, T pointY);
+    void remove(T pointX, T pointY);
+    void rebase(span<const T> seriesX, span<const T> seriesY);
+    void reset();
+};
+
+template <unsigned char maxSeriesLength, typename T>
+void QuadraticMomentSums<maxSeriesLength, T>::accumulate(const T pointX, const T pointY, const T sign)
+{
+    const T x = pointX - originX;
+    const T y = pointY - originY;
+    const T xSquare = x * x;
+
+    sumX += sign * x;
+    sumXSquare += sign * xSquare;
+    sumXCube += sign * xSquare * x;
+    sumXFourth += sign * xSquare * xSquare;
+    sumY += sign * y;
+    sumXY += sign * x * y;
+    sumXSquareY += sign * xSquare * y;
+    sumYSquare += sign * y * y;
+}
+
+template <unsigned char maxSeriesLength, typename T>
+bool QuadraticMomentSums<maxSeriesLength, T>::isRebaseDue() const
+{
+    return pushesSinceRebase >= maxSeriesLength;
+}
+
+template <unsigned char maxSeriesLength, typename T>
+T QuadraticMomentSums<maxSeriesLength, T>::goodnessOfFit(const T a, const T b, const T c) const
+{
+    // This function returns the R^2 as a goodness of fit indicator. The fit is moved to the origin of the sums first (y - originY = a * x^2 + (2 * a * originX + b) * x + (a * originX^2 + b * originX + c - originY)), then SSE is expanded into the moment sums
+    if (count < 3)
+    {
+        return 0;
+    }
+
+    const T n = static_cast<T>(count);
+    const T shiftedB = 2 * a * originX + b;
+    const T shiftedC = (a * originX + b) * originX + c - originY;
+
+    const T sst = sumYSquare - (sumY * sumY) / n;
+    const T sse = sumYSquare -
+                  2 * (a * sumXSquareY + shiftedB * sumXY + shiftedC * sumY) +
+                  a * a * sumXFourth +
+                  2 * a * shiftedB * sumXCube +
+                  (2 * a * shiftedC + shiftedB * shiftedB) * sumXSquare +
+                  2 * shiftedB * shiftedC * sumX +
+                  shiftedC * shiftedC * n;
+
+    if (sst <= 0 || sse > sst)
+    {
+        return 0;
+    }
+
+    if (sse <= 0)
+    {
+        return 1;
+    }
+
+    return 1 - (sse / sst);
+}
+
+template <unsigned char maxSeriesLength, typename T>
+void QuadraticMomentSums<maxSeriesLength, T>::add(const T pointX, const T pointY)
+{
+    if (count == 0)
+    {
+        originX = pointX;
+        originY = pointY;
+    }
+
+    accumulate(pointX, pointY, 1);
+    ++count;
+    ++pushesSinceRebase;
+}
+
+template <unsigned char maxSeriesLength, typename T>
+void QuadraticMomentSums<maxSeriesLength, T>::remove(const T pointX, const T pointY)
+{
+    accumulate(pointX, pointY, -1);
+    --count;
+}
+
+template <unsigned char maxSeriesLength, typename T>
+void QuadraticMomentSums<maxSeriesLength, T>::rebase(const span<const T> seriesX, const span<const T> seriesY)
+{
+    reset();
+    if (seriesX.empty())
+    {
+        return;
+    }
+
+    originX = seriesX[0];
+    originY = seriesY[0];
+    for (size_t i = 0; i < seriesX.size(); ++i)
+    {
+        accumulate(seriesX[i], seriesY[i], 1);
+    }
+    count = seriesX.size();
+}
+
+template <unsigned char maxSeriesLength, typename T>
+void QuadraticMomentSums<maxSeriesLength, T>::reset()
+{
+    originX = 0;
+    originY = 0;
+    pushesSinceRebase = 0;
+    count = 0;
+
+    sumX = 0;
+    sumXSquare = 0;
+    sumXCube = 0;
+    sumXFourth = 0;
+    sumY = 0;
+    sumXY = 0;
+    sumXSquareY = 0;
+    sumYSquare = 0;
+}
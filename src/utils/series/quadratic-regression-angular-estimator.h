@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+
+#include "../configuration.h"
+#include "./fixed-series.h"
+
+// Angular estimator on top of a quadratic (Theil-Sen) regression of the angular displacement window: every point of the window collects the derivatives of each regression it took part in, weighted by the goodness of fit of that regression, and the estimates are read at the oldest point of the window (i.e. with the lag of the window, in line with the delta time regression). The window length can be changed at run time between minWindowLength and windowLength (the points are stored for the longest window and a shorter one starts at the oldest point, so the estimates keep the lag of the full window). The regression is seeded with the origin (the flywheel at rest at zero time)
+template <typename TQuadraticSeries, unsigned char windowLength, unsigned char minWindowLength = windowLength>
+class QuadraticRegressionAngularEstimator
+{
+    typedef Configurations::accumulatorPrecision T;
+
+    static_assert(minWindowLength > 2 && minWindowLength <= windowLength, "QuadraticRegressionAngularEstimator requires at least three points and the minimum window length can not be longer than the window");
+    static_assert(windowLength < 255, "QuadraticRegressionAngularEstimator keeps one more point than the window");
+
+    // The derivatives of a regression are a line over the total time (first derivative 2a * x + b, second derivative 2a), so a regression is kept as its derivatives at the oldest point of its window and is only evaluated at the point being read. Points are counted from the last reset (including the seed) so a regression knows which rows (the points that were pushed, which lag the points of the regression by the seed until the window fills up) it contributed to
+    struct Regression
+    {
+        T firstDerivative;
+        T secondDerivative;
+        T originX;
+        T goodnessOfFit;
+        unsigned int firstRowPoint;
+        unsigned char rowOffset;
+        unsigned char rowCount;
+    };
+
+    unsigned char activeWindowLength = windowLength;
+    TQuadraticSeries angularDistances;
+    // Raw total time of the points, one more than the window so the seeded point is still there while the window fills up
+    FixedSeries<windowLength + 1, T> pointsX;
+    unsigned int pointCount = 0U;
+    unsigned char rowCount = 0;
+    // A regression only contributes to the points of its own window, so once a window length of newer regressions was pushed the oldest one is not needed anymore and is overwritten
+    std::array<Regression, windowLength> regressions{};
+    unsigned char regressionHead = 0;
+    unsigned char regressionCount = 0;
+
+    void pushPoint(T pointX, T pointY);
+
+public:
+    QuadraticRegressionAngularEstimator();
+
+    T angularVelocity() const;
+    T angularAcceleration() const;
+    T confidence() const;
+    unsigned char getWindowLength() const;
+
+    void setWindowLength(unsigned char length);
+    void push(T pointX, T pointY);
+    void reset();
+};
+
+template <typename TQuadraticSeries, unsigned char windowLength, unsigned char minWindowLength>
+QuadraticRegressionAngularEstimator<TQuadraticSeries, windowLength, minWindowLength>::QuadraticRegressionAngularEstimator()
+{
+    pushPoint(0, 0);
+}
+
+template <typename TQuadraticSeries, unsigned char windowLength, unsigned char minWindowLength>
+Configurations::accumulatorPrecision QuadraticRegressionAngularEstimator<TQuadraticSeries, windowLength, minWindowLength>::angularVelocity() const
+{
+    // The weighted average of the first derivatives the oldest row received, evaluated now from the coefficients of each regression (in O(window length), instead of evaluating every regression at every point of its window when it is pushed)
+    const unsigned int rowPoint = pointCount - rowCount;
+    T weighted = 0;
+    T weight = 0;
+    for (unsigned char i = 0; i < regressionCount; ++i)
+    {
+        const auto &regression = regressions[(regressionHead + i) % windowLength];
+        if (rowCount == 0 || rowPoint - regression.firstRowPoint >= regression.rowCount)
+        {
+            continue;
+        }
+
+        const auto pointX = pointsX[rowPoint - regression.rowOffset - (pointCount - pointsX.size())];
+        weighted += (regression.firstDerivative + regression.secondDerivative * (pointX - regression.originX)) * regression.goodnessOfFit;
+        weight += regression.goodnessOfFit;
+    }
+
+    if (weighted == 0)
+    {
+        return 0.0;
+    }
+
+    return weighted / weight;
+}
+
+template <typename TQuadraticSeries, unsigned char windowLength, unsigned char minWindowLength>
+Configurations::accumulatorPrecision QuadraticRegressionAngularEstimator<TQuadraticSeries, windowLength, minWindowLength>::angularAcceleration() const
+{
+    const unsigned int rowPoint = pointCount - rowCount;
+    T weighted = 0;
+    T weight = 0;
+    for (unsigned char i = 0; i < regressionCount; ++i)
+    {
+        const auto &regression = regressions[(regressionHead + i) % windowLength];
+        if (rowCount == 0 || rowPoint - regression.firstRowPoint >= regression.rowCount)
+        {
+            continue;
+        }
+
+        weighted += regression.secondDerivative * regression.goodnessOfFit;
+        weight += regression.goodnessOfFit;
+    }
+
+    if (weighted == 0)
+    {
+        return 0.0;
+    }
+
+    return weighted / weight;
+}
+
+template <typename TQuadraticSeries, unsigned char windowLength, unsigned char minWindowLength>
+Configurations::accumulatorPrecision QuadraticRegressionAngularEstimator<TQuadraticSeries, windowLength, minWindowLength>::confidence() const
+{
+    return angularDistances.goodnessOfFit();
+}
+
+template <typename TQuadraticSeries, unsigned char windowLength, unsigned char minWindowLength>
+unsigned char QuadraticRegressionAngularEstimator<TQuadraticSeries, windowLength, minWindowLength>::getWindowLength() const
+{
+    return activeWindowLength;
+}
+
+template <typename TQuadraticSeries, unsigned char windowLength, unsigned char minWindowLength>
+void QuadraticRegressionAngularEstimator<TQuadraticSeries, windowLength, minWindowLength>::setWindowLength(const unsigned char length)
+{
+    // Takes effect from the next push, the regression keeps the triples it already calculated so a shorter window does not lose anything and a longer one only calculates the triples of the points it takes in
+    activeWindowLength = std::clamp(length, minWindowLength, windowLength);
+    angularDistances.setWindowLength(activeWindowLength);
+}
+
+template <typename TQuadraticSeries, unsigned char windowLength, unsigned char minWindowLength>
+void QuadraticRegressionAngularEstimator<TQuadraticSeries, windowLength, minWindowLength>::pushPoint(const T pointX, const T pointY)
+{
+    angularDistances.push(pointX, pointY);
+    pointsX.push(pointX);
+    ++pointCount;
+}
+
+template <typename TQuadraticSeries, unsigned char windowLength, unsigned char minWindowLength>
+void QuadraticRegressionAngularEstimator<TQuadraticSeries, windowLength, minWindowLength>::push(const T pointX, const T pointY)
+{
+    pushPoint(pointX, pointY);
+    if (rowCount < windowLength)
+    {
+        ++rowCount;
+    }
+
+    const unsigned char seriesSize = std::min<unsigned int>(pointCount, windowLength);
+    const unsigned int firstRowPoint = pointCount - rowCount;
+    const Regression regression = {
+        .firstDerivative = angularDistances.firstDerivativeAtPosition(0),
+        .secondDerivative = angularDistances.secondDerivativeAtPosition(0),
+        .originX = pointsX[pointsX.size() - seriesSize],
+        .goodnessOfFit = angularDistances.goodnessOfFit(),
+        .firstRowPoint = firstRowPoint,
+        .rowOffset = static_cast<unsigned char>(firstRowPoint - (pointCount - seriesSize)),
+        .rowCount = std::min(rowCount, activeWindowLength),
+    };
+    if (regressionCount < windowLength)
+    {
+        regressions[(regressionHead + regressionCount) % windowLength] = regression;
+        ++regressionCount;
+
+        return;
+    }
+
+    regressions[regressionHead] = regression;
+    regressionHead = (regressionHead + 1) % windowLength;
+}
+
+template <typename TQuadraticSeries, unsigned char windowLength, unsigned char minWindowLength>
+void QuadraticRegressionAngularEstimator<TQuadraticSeries, windowLength, minWindowLength>::reset()
+{
+    angularDistances.reset();
+    pointsX.reset();
+    pointCount = 0U;
+    rowCount = 0;
+    regressionHead = 0;
+    regressionCount = 0;
+}
@@ -0,0 +1,373 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "../configuration.h"
+#include "./fixed-series.h"
+#include "./median-network.h"
+
+// Savitzky-Golay style angular estimator: the impulses are evenly spaced in angle (not in time), so the quadratic least squares fit of the total time as a function of the impulse index has convolution coefficients that only depend on the window length. These are generated at compile time and the fit is a dot product over the window, from which the angular velocity and acceleration follow as omega = h / t'(u) and alpha = -2h * c2 / t'(u)^3 (u is the impulse index, h the angular displacement per impulse and c2 the quadratic coefficient). A robust pass reweights the points by their residuals (Tukey bisquare scaled by the median absolute residual) and refits with the weights when an outlier impulse is found. The window length can be changed at run time between minWindowLength and windowLength (the points are stored for the longest window and there are coefficient tables for every length). The estimates are read at the oldest point of the window, in line with the regression estimators and the delta time regression
+template <unsigned char windowLength, unsigned char minWindowLength = windowLength, typename T = Configurations::accumulatorPrecision>
+class SavitzkyGolayAngularEstimator
+{
+    static_assert(minWindowLength > 2 && minWindowLength <= windowLength, "SavitzkyGolayAngularEstimator requires at least three points and the minimum window length can not be longer than the window");
+
+    static constexpr unsigned char windowLengthCount = windowLength - minWindowLength + 1;
+
+    static constexpr T tukeyConstant = 4.685;
+    // The reweighting is repeated (with the weighted fit) while it finds outliers, as one outlier can still hide another from the first pass
+    static constexpr unsigned char robustIterations = 3;
+    static constexpr T medianAbsoluteDeviationScale = 1.4826;
+    // Lower bound of the residual scale, the resolution of the impulse times (1us), so rounding noise on a perfect fit is not taken for outliers
+    static constexpr T minimumResidualScale = 1e-6;
+
+    struct QuadraticFit
+    {
+        T intercept = 0;
+        T slope = 0;
+        T curvature = 0;
+
+        T at(const unsigned char u) const
+        {
+            return intercept + slope * u + curvature * u * u;
+        }
+    };
+
+    // Rows of the inverse of the normal equations of a quadratic fit on the indices 0..n - 1 with the given weighted moments (sum of w * u^j for j = 0..4), by Cramer's rule
+    static constexpr std::array<std::array<T, 3>, 3> inverseNormalMatrix(const std::array<T, 5> &moments)
+    {
+        const T m0 = moments[0];
+        const T m1 = moments[1];
+        const T m2 = moments[2];
+        const T m3 = moments[3];
+        const T m4 = moments[4];
+
+        const T determinant = m0 * (m2 * m4 - m3 * m3) - m1 * (m1 * m4 - m2 * m3) + m2 * (m1 * m3 - m2 * m2);
+        if (determinant == 0)
+        {
+            return {};
+        }
+
+        return {{
+            {(m2 * m4 - m3 * m3) / determinant, (m2 * m3 - m1 * m4) / determinant, (m1 * m3 - m2 * m2) / determinant},
+            {(m2 * m3 - m1 * m4) / determinant, (m0 * m4 - m2 * m2) / determinant, (m1 * m2 - m0 * m3) / determinant},
+            {(m1 * m3 - m2 * m2) / determinant, (m1 * m2 - m0 * m3) / determinant, (m0 * m2 - m1 * m1) / determinant},
+        }};
+    }
+
+    static constexpr std::array<std::array<T, 3>, 3> unweightedInverseNormalMatrix(const unsigned char size)
+    {
+        std::array<T, 5> moments{};
+        for (unsigned char u = 0; u < size; ++u)
+        {
+            T power = 1;
+            for (auto &moment : moments)
+            {
+                moment += power;
+                power *= u;
+            }
+        }
+
+        return inverseNormalMatrix(moments);
+    }
+
+    // Leverage (diagonal of the hat matrix) of every point of an unweighted fit, used to find the point with the largest leave one out residual (the residual of a point against the fit of all the others)
+    static constexpr std::array<T, windowLength> leverages(const unsigned char size)
+    {
+        const auto inverse = unweightedInverseNormalMatrix(size);
+
+        std::array<T, windowLength> values{};
+        for (unsigned char u = 0; u < size; ++u)
+        {
+            const std::array<T, 3> powers = {1, static_cast<T>(u), static_cast<T>(u * u)};
+            for (unsigned char i = 0; i < 3; ++i)
+            {
+                for (unsigned char j = 0; j < 3; ++j)
+                {
+                    values[u] += powers[i] * inverse[i][j] * powers[j];
+                }
+            }
+        }
+
+        return values;
+    }
+
+    // Convolution coefficients for the intercept, the slope and the quadratic coefficient of the fit at the oldest point, for every window length from minWindowLength up
+    static constexpr std::array<std::array<std::array<T, windowLength>, 3>, windowLengthCount> coefficients = []()
+    {
+        std::array<std::array<std::array<T, windowLength>, 3>, windowLengthCount> tables{};
+        for (unsigned char length = minWindowLength; length <= windowLength; ++length)
+        {
+            const auto inverse = unweightedInverseNormalMatrix(length);
+            auto &rows = tables[length - minWindowLength];
+            for (unsigned char i = 0; i < 3; ++i)
+            {
+                for (unsigned char u = 0; u < length; ++u)
+                {
+                    rows[i][u] = inverse[i][0] + inverse[i][1] * u + inverse[i][2] * u * u;
+                }
+            }
+        }
+
+        return tables;
+    }();
+    static constexpr std::array<std::array<T, windowLength>, windowLengthCount> windowLeverages = []()
+    {
+        std::array<std::array<T, windowLength>, windowLengthCount> tables{};
+        for (unsigned char length = minWindowLength; length <= windowLength; ++length)
+        {
+            tables[length - minWindowLength] = leverages(length);
+        }
+
+        return tables;
+    }();
+
+    unsigned char activeWindowLength = windowLength;
+    // The fit only depends on the points of the window, so it is calculated when the estimates are first read after a push (over the window length of that push) rather than on every push
+    unsigned char fitWindowLength = windowLength;
+    bool isCalculated = true;
+
+    T velocity = 0;
+    T acceleration = 0;
+    T lastConfidence = 0;
+    FixedSeries<windowLength, T> seriesX;
+    FixedSeries<windowLength, T> seriesY;
+    std::array<T, windowLength> weights{};
+
+    QuadraticFit fit(unsigned char size) const;
+    QuadraticFit weightedFit(unsigned char size) const;
+    unsigned char mostInfluentialPoint(QuadraticFit quadraticFit, unsigned char size) const;
+    bool reweight(QuadraticFit quadraticFit, unsigned char size);
+    void calculateDerivatives();
+
+public:
+    SavitzkyGolayAngularEstimator();
+
+    T angularVelocity();
+    T angularAcceleration();
+    T confidence();
+
+    unsigned char getWindowLength() const;
+    void setWindowLength(unsigned char length);
+
+    void push(T pointX, T pointY);
+    void reset();
+};
+
+template <unsigned char windowLength, unsigned char minWindowLength, typename T>
+SavitzkyGolayAngularEstimator<windowLength, minWindowLength, T>::SavitzkyGolayAngularEstimator()
+{
+    push(0, 0);
+}
+
+template <unsigned char windowLength, unsigned char minWindowLength, typename T>
+typename SavitzkyGolayAngularEstimator<windowLength, minWindowLength, T>::QuadraticFit SavitzkyGolayAngularEstimator<windowLength, minWindowLength, T>::fit(const unsigned char size) const
+{
+    // The times are taken relative to the oldest point, so the fit is not calculated from the session long total time
+    if (size >= minWindowLength)
+    {
+        const auto &rows = coefficients[size - minWindowLength];
+        QuadraticFit quadraticFit;
+        for (unsigned char u = 1; u < size; ++u)
+        {
+            const T relativeX = seriesX[u] - seriesX[0];
+            quadraticFit.intercept += rows[0][u] * relativeX;
+            quadraticFit.slope += rows[1][u] * relativeX;
+            quadraticFit.curvature += rows[2][u] * relativeX;
+        }
+
+        return quadraticFit;
+    }
+
+    return weightedFit(size);
+}
+
+template <unsigned char windowLength, unsigned char minWindowLength, typename T>
+typename SavitzkyGolayAngularEstimator<windowLength, minWindowLength, T>::QuadraticFit SavitzkyGolayAngularEstimator<windowLength, minWindowLength, T>::weightedFit(const unsigned char size) const
+{
+    // Same fit as the convolution with runtime weights (and window length while the window fills up to the minimum window length)
+    std::array<T, 5> moments{};
+    std::array<T, 3> timeMoments{};
+    for (unsigned char u = 0; u < size; ++u)
+    {
+        const T relativeX = seriesX[u] - seriesX[0];
+        T power = weights[u];
+        for (unsigned char j = 0; j < moments.size(); ++j)
+        {
+            moments[j] += power;
+            if (j < timeMoments.size())
+            {
+                timeMoments[j] += power * relativeX;
+            }
+            power *= u;
+        }
+    }
+    const auto inverse = inverseNormalMatrix(moments);
+
+    return {
+        inverse[0][0] * timeMoments[0] + inverse[0][1] * timeMoments[1] + inverse[0][2] * timeMoments[2],
+        inverse[1][0] * timeMoments[0] + inverse[1][1] * timeMoments[1] + inverse[1][2] * timeMoments[2],
+        inverse[2][0] * timeMoments[0] + inverse[2][1] * timeMoments[1] + inverse[2][2] * timeMoments[2],
+    };
+}
+
+template <unsigned char windowLength, unsigned char minWindowLength, typename T>
+unsigned char SavitzkyGolayAngularEstimator<windowLength, minWindowLength, T>::mostInfluentialPoint(const QuadraticFit quadraticFit, const unsigned char size) const
+{
+    const auto pointLeverages = size >= minWindowLength ? windowLeverages[size - minWindowLength] : leverages(size);
+    unsigned char point = 0;
+    T maxResidual = 0;
+    for (unsigned char u = 0; u < size; ++u)
+    {
+        const T residual = std::abs(seriesX[u] - seriesX[0] - quadraticFit.at(u)) / (1 - pointLeverages[u]);
+        if (residual > maxResidual)
+        {
+            maxResidual = residual;
+            point = u;
+        }
+    }
+
+    return point;
+}
+
+template <unsigned char windowLength, unsigned char minWindowLength, typename T>
+bool SavitzkyGolayAngularEstimator<windowLength, minWindowLength, T>::reweight(const QuadraticFit quadraticFit, const unsigned char size)
+{
+    std::array<T, windowLength> residuals{};
+    std::array<T, windowLength> deviations{};
+    for (unsigned char u = 0; u < size; ++u)
+    {
+        residuals[u] = seriesX[u] - seriesX[0] - quadraticFit.at(u);
+        deviations[u] = std::abs(residuals[u]);
+    }
+
+    const T medianDeviation = MedianNetwork::select(span<T>(deviations.data(), size));
+    const T limit = tukeyConstant * std::max(medianAbsoluteDeviationScale * medianDeviation, minimumResidualScale);
+
+    bool hasOutlier = false;
+    for (unsigned char u = 0; u < size; ++u)
+    {
+        const T scaledResidual = residuals[u] / limit;
+        const T weight = std::abs(scaledResidual) < 1 ? (1 - scaledResidual * scaledResidual) * (1 - scaledResidual * scaledResidual) : 0;
+        weights[u] = weight;
+        hasOutlier = hasOutlier || weight == 0;
+    }
+
+    return hasOutlier;
+}
+
+template <unsigned char windowLength, unsigned char minWindowLength, typename T>
+void SavitzkyGolayAngularEstimator<windowLength, minWindowLength, T>::calculateDerivatives()
+{
+    // A window shorter than the stored points starts at the oldest point, so the estimates keep the lag of the full window (that of the delta time regression)
+    const unsigned char size = std::min<unsigned char>(seriesX.size(), fitWindowLength);
+    isCalculated = true;
+    velocity = 0;
+    acceleration = 0;
+    lastConfidence = 0;
+    if (size < 3)
+    {
+        return;
+    }
+
+    weights.fill(1);
+    auto quadraticFit = fit(size);
+
+    // An outlier pulls the unweighted fit (and so the residuals of every other point) towards itself, which would hide it in the residual scale. So the residuals are taken against a fit without the point that has the largest leave one out residual, and the fit is only repeated with the robust weights while there are outliers (points with zero weight). Four or fewer points leave nothing to compare the residuals to
+    if (size > 4)
+    {
+        weights[mostInfluentialPoint(quadraticFit, size)] = 0;
+        auto robustFit = weightedFit(size);
+        for (unsigned char iteration = 0; iteration < robustIterations && reweight(robustFit, size); ++iteration)
+        {
+            robustFit = weightedFit(size);
+            quadraticFit = robustFit;
+        }
+    }
+
+    // The confidence is the average robust weight of the points
+    T weightSum = 0;
+    for (unsigned char u = 0; u < size; ++u)
+    {
+        weightSum += weights[u];
+    }
+    lastConfidence = weightSum / size;
+
+    // Derivatives of the time over the impulse index at the oldest point (u = 0) converted to the angular velocity and acceleration
+    const T angularDisplacementPerImpulse = (seriesY[size - 1] - seriesY[0]) / (size - 1);
+    if (quadraticFit.slope <= 0)
+    {
+        return;
+    }
+
+    velocity = angularDisplacementPerImpulse / quadraticFit.slope;
+    acceleration = -2 * angularDisplacementPerImpulse * quadraticFit.curvature / (quadraticFit.slope * quadraticFit.slope * quadraticFit.slope);
+}
+
+template <unsigned char windowLength, unsigned char minWindowLength, typename T>
+T SavitzkyGolayAngularEstimator<windowLength, minWindowLength, T>::angularVelocity()
+{
+    if (!isCalculated)
+    {
+        calculateDerivatives();
+    }
+
+    return velocity;
+}
+
+template <unsigned char windowLength, unsigned char minWindowLength, typename T>
+T SavitzkyGolayAngularEstimator<windowLength, minWindowLength, T>::angularAcceleration()
+{
+    if (!isCalculated)
+    {
+        calculateDerivatives();
+    }
+
+    return acceleration;
+}
+
+template <unsigned char windowLength, unsigned char minWindowLength, typename T>
+T SavitzkyGolayAngularEstimator<windowLength, minWindowLength, T>::confidence()
+{
+    if (!isCalculated)
+    {
+        calculateDerivatives();
+    }
+
+    return lastConfidence;
+}
+
+template <unsigned char windowLength, unsigned char minWindowLength, typename T>
+unsigned char SavitzkyGolayAngularEstimator<windowLength, minWindowLength, T>::getWindowLength() const
+{
+    return activeWindowLength;
+}
+
+template <unsigned char windowLength, unsigned char minWindowLength, typename T>
+void SavitzkyGolayAngularEstimator<windowLength, minWindowLength, T>::setWindowLength(const unsigned char length)
+{
+    // Takes effect from the next push, the points are always stored for the longest window so changing the length does not lose (or need to rebuild) anything
+    activeWindowLength = std::clamp(length, minWindowLength, windowLength);
+}
+
+template <unsigned char windowLength, unsigned char minWindowLength, typename T>
+void SavitzkyGolayAngularEstimator<windowLength, minWindowLength, T>::push(const T pointX, const T pointY)
+{
+    seriesX.push(pointX);
+    seriesY.push(pointY);
+    fitWindowLength = activeWindowLength;
+    isCalculated = false;
+}
+
+template <unsigned char windowLength, unsigned char minWindowLength, typename T>
+void SavitzkyGolayAngularEstimator<windowLength, minWindowLength, T>::reset()
+{
+    velocity = 0;
+    acceleration = 0;
+    lastConfidence = 0;
+    isCalculated = true;
+    seriesX.reset();
+    seriesY.reset();
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <span>
+
+using std::size_t;
+using std::span;
+
+// Inner loops of the Theil-Sen regressions over structure of arrays inputs (separate contiguous X and Y ranges). The degenerate equal X cases are masked with selects instead of early returns so the loops have no data dependent branches and the compiler can auto-vectorise them (SSE/AVX/NEON on the host). The arithmetic is done in the input type and only the result is converted to the (possibly narrower) output type. These are the only place the hot arithmetic lives, so target specific implementations (e.g. the ESP32-S3 PIE instructions) can be added here without touching the regression classes
+namespace SeriesKernels
+{
+    // Slopes from every point of the series to the given (later) point, i.e. (pointY - y[i]) / (pointX - x[i]), or zero if the X coordinates are equal
+    template <typename T, typename TResult = T>
+    void slopesToPoint(const span<const T> seriesX, const span<const T> seriesY, const T pointX, const T pointY, const span<TResult> slopes)
+    {
+        const auto *const __restrict x = seriesX.data();
+        const auto *const __restrict y = seriesY.data();
+        auto *const __restrict result = slopes.data();
+        const auto size = seriesX.size();
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            const T deltaX = pointX - x[i];
+            const bool isDegenerate = deltaX == 0;
+            const T slope = (pointY - y[i]) / (isDegenerate ? 1 : deltaX);
+            result[i] = isDegenerate ? 0 : static_cast<TResult>(slope);
+        }
+    }
+
+    // Slopes from the given (earlier) point to every point of the series, i.e. (y[i] - pointY) / (x[i] - pointX), or zero if the X coordinates are equal
+    template <typename T, typename TResult = T>
+    void slopesFromPoint(const T pointX, const T pointY, const span<const T> seriesX, const span<const T> seriesY, const span<TResult> slopes)
+    {
+        const auto *const __restrict x = seriesX.data();
+        const auto *const __restrict y = seriesY.data();
+        auto *const __restrict result = slopes.data();
+        const auto size = seriesX.size();
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            const T deltaX = x[i] - pointX;
+            const bool isDegenerate = deltaX == 0;
+            const T slope = (y[i] - pointY) / (isDegenerate ? 1 : deltaX);
+            result[i] = isDegenerate ? 0 : static_cast<TResult>(slope);
+        }
+    }
+
+    // Quadratic coefficient (A) of the parabola through the three points, or zero if any two X coordinates are equal
+    template <typename T>
+    T coefficientA(const T firstX, const T firstY, const T middleX, const T middleY, const T lastX, const T lastY)
+    {
+        const T deltaXFirstMiddle = firstX - middleX;
+        const T deltaXFirstLast = firstX - lastX;
+        const T deltaXMiddleLast = middleX - lastX;
+        const bool isDegenerate = deltaXFirstMiddle == 0 || deltaXFirstLast == 0 || deltaXMiddleLast == 0;
+        const T numerator = firstX * (lastY - middleY) +
+                            firstY * deltaXMiddleLast +
+                            (lastX * middleY - middleX * lastY);
+        const T denominator = deltaXFirstMiddle * deltaXFirstLast * deltaXMiddleLast;
+        const T coefficient = numerator / (isDegenerate ? 1 : denominator);
+
+        return isDegenerate ? 0 : coefficient;
+    }
+
+    // Quadratic coefficient (A) of the parabolas through the first point, every middle point of the series and the last point, or zero if any two X coordinates are equal
+    template <typename T, typename TResult = T>
+    void coefficientsA(const T firstX, const T firstY, const span<const T> middleX, const span<const T> middleY, const T lastX, const T lastY, const span<TResult> coefficients)
+    {
+        const auto *const __restrict x = middleX.data();
+        const auto *const __restrict y = middleY.data();
+        auto *const __restrict result = coefficients.data();
+        const auto size = middleX.size();
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            result[i] = static_cast<TResult>(coefficientA(firstX, firstY, x[i], y[i], lastX, lastY));
+        }
+    }
+
+    // Slopes between the points with the same index of the two series, i.e. (toY[i] - fromY[i]) / (toX[i] - fromX[i]), or zero if the X coordinates are equal
+    template <typename T, typename TResult = T>
+    void slopesBetween(const span<const T> fromX, const span<const T> fromY, const span<const T> toX, const span<const T> toY, const span<TResult> slopes)
+    {
+        const auto *const __restrict x = fromX.data();
+        const auto *const __restrict y = fromY.data();
+        const auto *const __restrict otherX = toX.data();
+        const auto *const __restrict otherY = toY.data();
+        auto *const __restrict result = slopes.data();
+        const auto size = fromX.size();
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            const T deltaX = otherX[i] - x[i];
+            const bool isDegenerate = deltaX == 0;
+            const T slope = (otherY[i] - y[i]) / (isDegenerate ? 1 : deltaX);
+            result[i] = isDegenerate ? 0 : static_cast<TResult>(slope);
+        }
+    }
+}
@@ -1,11 +1,19 @@
 #include <algorithm>
+#include <array>
 
+#include "./median-network.h"
 #include "./series.h"
 
 using std::vector;
 
 const Configurations::precision &Series::operator[](size_t index) const
 {
+    index += head;
+    if (index >= seriesArray.size())
+    {
+        index -= seriesArray.size();
+    }
+
     return seriesArray[index];
 };
 
@@ -36,6 +44,15 @@ Configurations::precision Series::median() const
         return 0.0;
     }
 
+    // Small series (the usual case) are copied onto the stack and go through the selection network of their size
+    if (seriesArray.size() <= MedianNetwork::maxNetworkSize)
+    {
+        std::array<Configurations::precision, MedianNetwork::maxNetworkSize> selection{};
+        std::copy(cbegin(seriesArray), cend(seriesArray), begin(selection));
+
+        return MedianNetwork::select(span<Configurations::precision>(selection.data(), seriesArray.size()));
+    }
+
     const unsigned int mid = seriesArray.size() / 2;
     vector<Configurations::precision> sortedArray(mid + 1);
     // Note: it has been tested that partial_sort_copy implementation performs better than nth_element in any constellation for this situation. I assume it is the copying to the new array that cost more than O(n) time complexity of nth_element brings to the table
@@ -50,9 +67,17 @@ void Series::push(const Configurations::precision value)
 {
     if (maxSeriesLength > 0 && seriesArray.size() >= maxSeriesLength)
     {
-        // The maximum of the array has been reached, we have to create room by removing the first value from the array
-        seriesSum -= seriesArray[0];
-        seriesArray.erase(begin(seriesArray));
+        // The maximum of the array has been reached, the oldest value (at the head) is replaced by the new one and the head moves to the next oldest value
+        seriesSum -= seriesArray[head];
+        seriesArray[head] = value;
+        seriesSum += value;
+        ++head;
+        if (head == seriesArray.size())
+        {
+            head = 0;
+        }
+
+        return;
     }
 
     // Do manual memory reallocation via reserve if size is not known for better memory management
@@ -77,6 +102,7 @@ void Series::reset()
     clear.reserve(maxSeriesLength > 0 ? maxSeriesLength : std::min<unsigned int>(seriesArray.size(), maxAllocationCapacity));
     seriesArray.swap(clear);
 
+    head = 0;
     seriesSum = 0;
 }
 
@@ -11,6 +11,8 @@ class Series
     unsigned char maxSeriesLength;
     unsigned short maxAllocationCapacity;
     Configurations::precision seriesSum = 0;
+    // Once a length limited series is full it is used as a ring buffer: the oldest value sits at the head and a new value overwrites it
+    unsigned char head = 0;
     std::vector<Configurations::precision> seriesArray;
 
 public:
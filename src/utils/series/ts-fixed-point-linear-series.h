@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <climits>
+
+#include "../configuration.h"
+#include "./fixed-series.h"
+#include "./order-statistic-pool.h"
+
+// Integer counterpart of TSLinearSeries for the delta time regression: X (total time) and Y (delta time) are integer microseconds, the pairwise slopes are kept as Q32 fixed point integers, so pushing a point and keeping the ordered slope pool only uses integer arithmetic and comparisons (which are native on the ESP32 unlike double precision floating point)
+template <unsigned char maxSeriesLength>
+class TSFixedPointLinearSeries
+{
+    static_assert(maxSeriesLength > 1, "TSFixedPointLinearSeries requires at least two points");
+
+    static constexpr unsigned short maxSlopeSeriesLength = (maxSeriesLength * (maxSeriesLength - 1)) / 2;
+    static constexpr unsigned char slopeFractionBits = 32;
+    static constexpr long long slopeScale = 1LL << slopeFractionBits;
+    // The Y difference is shifted by slopeFractionBits so it is saturated to keep the shifted value in range. This only kicks in for delta times above ~35 minutes, i.e. when the flywheel has stopped anyway
+    static constexpr long long maxDeltaY = LLONG_MAX / slopeScale;
+
+    bool shouldRecalculateA = true;
+    Configurations::precision a = 0;
+
+    FixedSeries<maxSeriesLength, long long> seriesX;
+    FixedSeries<maxSeriesLength, long long> seriesY;
+    // Same triangular ring layout as TSLinearSeries: the pairs with the same distance between their points form one ring (of maxSeriesLength - distance slots) stored back to back in a single contiguous array
+    std::array<long long, maxSlopeSeriesLength> slopes{};
+    std::array<unsigned char, maxSeriesLength> slopeHeads{};
+    OrderStatisticPool<long long> orderedSlopes = OrderStatisticPool<long long>(maxSlopeSeriesLength);
+
+    long long calculateSlope(unsigned char pointOne, unsigned char pointTwo) const;
+    static constexpr unsigned short slopeRingOffset(unsigned char distance);
+    unsigned short slopeIndex(unsigned char pointOne, unsigned char pointTwo) const;
+
+public:
+    long long yAtSeriesBegin() const;
+    Configurations::precision median() const;
+    Configurations::precision coefficientA();
+    size_t size() const;
+
+    void push(long long pointX, long long pointY);
+    void reset();
+};
+
+template <unsigned char maxSeriesLength>
+long long TSFixedPointLinearSeries<maxSeriesLength>::calculateSlope(const unsigned char pointOne, const unsigned char pointTwo) const
+{
+    const auto deltaX = seriesX[pointTwo] - seriesX[pointOne];
+
+    if (pointOne == pointTwo || deltaX == 0)
+    {
+        return 0;
+    }
+
+    const auto deltaY = std::clamp(seriesY[pointTwo] - seriesY[pointOne], -maxDeltaY, maxDeltaY);
+
+    return (deltaY * slopeScale) / deltaX;
+}
+
+template <unsigned char maxSeriesLength>
+long long TSFixedPointLinearSeries<maxSeriesLength>::yAtSeriesBegin() const
+{
+    return seriesY[0];
+}
+
+template <unsigned char maxSeriesLength>
+Configurations::precision TSFixedPointLinearSeries<maxSeriesLength>::coefficientA()
+{
+    if (shouldRecalculateA)
+    {
+        a = median();
+        shouldRecalculateA = false;
+    }
+
+    return a;
+}
+
+template <unsigned char maxSeriesLength>
+Configurations::precision TSFixedPointLinearSeries<maxSeriesLength>::median() const
+{
+    return static_cast<Configurations::precision>(static_cast<double>(orderedSlopes.median()) / slopeScale);
+}
+
+template <unsigned char maxSeriesLength>
+constexpr unsigned short TSFixedPointLinearSeries<maxSeriesLength>::slopeRingOffset(const unsigned char distance)
+{
+    return (distance - 1) * maxSeriesLength - ((distance - 1) * distance) / 2;
+}
+
+template <unsigned char maxSeriesLength>
+unsigned short TSFixedPointLinearSeries<maxSeriesLength>::slopeIndex(const unsigned char pointOne, const unsigned char pointTwo) const
+{
+    const unsigned char distance = pointTwo - pointOne;
+    const unsigned char ringLength = maxSeriesLength - distance;
+
+    return slopeRingOffset(distance) + (slopeHeads[distance] + pointOne) % ringLength;
+}
+
+template <unsigned char maxSeriesLength>
+void TSFixedPointLinearSeries<maxSeriesLength>::push(const long long pointX, const long long pointY)
+{
+    if (seriesX.size() >= maxSeriesLength)
+    {
+        for (unsigned char distance = 1; distance < maxSeriesLength; ++distance)
+        {
+            orderedSlopes.erase(slopes[slopeIndex(0, distance)]);
+            slopeHeads[distance] = (slopeHeads[distance] + 1) % (maxSeriesLength - distance);
+        }
+    }
+
+    seriesX.push(pointX);
+    seriesY.push(pointY);
+    shouldRecalculateA = true;
+
+    if (seriesX.size() > 1)
+    {
+        const unsigned char newPoint = seriesX.size() - 1;
+        for (unsigned char i = 0; i < newPoint; ++i)
+        {
+            const auto result = calculateSlope(i, newPoint);
+            slopes[slopeIndex(i, newPoint)] = result;
+            orderedSlopes.insert(result);
+        }
+    }
+}
+
+template <unsigned char maxSeriesLength>
+void TSFixedPointLinearSeries<maxSeriesLength>::reset()
+{
+    seriesX.reset();
+    seriesY.reset();
+
+    slopeHeads.fill(0);
+    orderedSlopes.reset();
+
+    a = 0;
+}
+
+template <unsigned char maxSeriesLength>
+size_t TSFixedPointLinearSeries<maxSeriesLength>::size() const
+{
+    return seriesY.size();
+}
@@ -1,42 +1,185 @@
 #pragma once
 
-#include <vector>
+#include <algorithm>
+#include <array>
 
 #include "../configuration.h"
-#include "./series.h"
-
-using std::vector;
+#include "./fixed-series.h"
+#include "./order-statistic-pool.h"
+#include "./precision-policy.h"
+#include "./series-kernels.h"
 
+template <unsigned char maxSeriesLength, typename TPrecision = PrecisionPolicy<Configurations::precision>>
 class TSLinearSeries
 {
-    const unsigned char maxSeriesLength;
-    const unsigned short maxSlopeSeriesLength = ((maxSeriesLength - 2) * (maxSeriesLength - 1)) / 2;
+    typedef typename TPrecision::storage storage;
+    typedef typename TPrecision::compute compute;
+
+    static_assert(maxSeriesLength > 1, "TSLinearSeries requires at least two points");
+
+    static constexpr unsigned short maxSlopeSeriesLength = (maxSeriesLength * (maxSeriesLength - 1)) / 2;
+
     bool shouldRecalculateB = true;
     bool shouldRecalculateA = true;
-    Configurations::precision a = 0;
-    Configurations::precision b = 0;
+    compute a = 0;
+    compute b = 0;
 
-    Series seriesX;
-    Series seriesY;
-    vector<vector<Configurations::precision>> slopes;
+    // X is stored relative to an origin (the first point, then the oldest point of the window when last rebased), so the pairwise differences of the session long total time do not lose precision. The slopes do not depend on the origin, only the intercept is moved back in coefficientB()
+    compute originX = 0;
+    unsigned char pushesSinceRebase = 0;
+    FixedSeries<maxSeriesLength, compute> seriesX;
+    FixedSeries<maxSeriesLength, compute> seriesY;
+    // Triangular ring of the pairwise slopes: the pairs with the same distance between their points form one ring (of maxSeriesLength - distance slots), and these rings are stored back to back in a single contiguous array
+    std::array<storage, maxSlopeSeriesLength> slopes{};
+    std::array<unsigned char, maxSeriesLength> slopeHeads{};
+    std::array<storage, maxSeriesLength> newSlopes{};
+    OrderStatisticPool<storage> orderedSlopes = OrderStatisticPool<storage>(maxSlopeSeriesLength);
 
-    Configurations::precision calculateSlope(unsigned char pointOne, unsigned char pointTwo) const;
+    static constexpr unsigned short slopeRingOffset(unsigned char distance);
+    unsigned short slopeIndex(unsigned char pointOne, unsigned char pointTwo) const;
+    void rebase();
 
 public:
-    constexpr explicit TSLinearSeries(const unsigned char _maxSeriesLength = 0, const unsigned short _maxAllocationCapacity = 1'000) : maxSeriesLength(_maxSeriesLength), seriesX(_maxSeriesLength, _maxAllocationCapacity), seriesY(_maxSeriesLength, _maxAllocationCapacity)
+    compute yAtSeriesBegin() const;
+    compute median() const;
+    compute coefficientA();
+    compute coefficientB();
+    size_t size() const;
+
+    void push(compute pointX, compute pointY);
+    void reset();
+};
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+typename TPrecision::compute TSLinearSeries<maxSeriesLength, TPrecision>::yAtSeriesBegin() const
+{
+    return seriesY[0];
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+typename TPrecision::compute TSLinearSeries<maxSeriesLength, TPrecision>::coefficientA()
+{
+    if (shouldRecalculateA)
     {
-        if (_maxSeriesLength > 0)
+        a = median();
+        shouldRecalculateA = false;
+    }
+
+    return a;
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+typename TPrecision::compute TSLinearSeries<maxSeriesLength, TPrecision>::coefficientB()
+{
+    if (shouldRecalculateB)
+    {
+        a = median();
+
+        auto i = 0U;
+        FixedSeries<maxSeriesLength, compute> intercepts;
+        while (i + 1 < seriesX.size())
         {
-            slopes.reserve(_maxSeriesLength);
+            intercepts.push((seriesY[i] - (a * seriesX[i])));
+            ++i;
         }
+        b = intercepts.median() - a * originX;
+        shouldRecalculateB = false;
     }
 
-    Configurations::precision yAtSeriesBegin() const;
-    Configurations::precision median() const;
-    Configurations::precision coefficientA();
-    Configurations::precision coefficientB();
-    size_t size() const;
+    return b;
+}
 
-    void push(Configurations::precision pointX, Configurations::precision pointY);
-    void reset();
-};
\ No newline at end of file
+template <unsigned char maxSeriesLength, typename TPrecision>
+typename TPrecision::compute TSLinearSeries<maxSeriesLength, TPrecision>::median() const
+{
+    return static_cast<compute>(orderedSlopes.median());
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+constexpr unsigned short TSLinearSeries<maxSeriesLength, TPrecision>::slopeRingOffset(const unsigned char distance)
+{
+    // Rings are ordered by the distance of the points, the ring of distance d starts after the rings of the shorter distances (i.e. after sum(maxSeriesLength - 1 .. maxSeriesLength - d + 1) slots)
+    return (distance - 1) * maxSeriesLength - ((distance - 1) * distance) / 2;
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+unsigned short TSLinearSeries<maxSeriesLength, TPrecision>::slopeIndex(const unsigned char pointOne, const unsigned char pointTwo) const
+{
+    const unsigned char distance = pointTwo - pointOne;
+    const unsigned char ringLength = maxSeriesLength - distance;
+
+    return slopeRingOffset(distance) + (slopeHeads[distance] + pointOne) % ringLength;
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+void TSLinearSeries<maxSeriesLength, TPrecision>::rebase()
+{
+    const auto offset = seriesX[0];
+    seriesX.shift(offset);
+    originX += offset;
+    pushesSinceRebase = 0;
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+void TSLinearSeries<maxSeriesLength, TPrecision>::push(const compute pointX, const compute pointY)
+{
+    if (seriesX.size() == 0)
+    {
+        originX = pointX;
+        pushesSinceRebase = 0;
+    }
+    else if (pushesSinceRebase >= maxSeriesLength)
+    {
+        rebase();
+    }
+    const compute x = pointX - originX;
+    ++pushesSinceRebase;
+
+    if (seriesX.size() >= maxSeriesLength)
+    {
+        // The maximum of the array has been reached, the slopes of the oldest point are removed from the ordered pool and the heads of the rings are advanced so their slots are reused by the slopes of the new point
+        for (unsigned char distance = 1; distance < maxSeriesLength; ++distance)
+        {
+            orderedSlopes.erase(slopes[slopeIndex(0, distance)]);
+            slopeHeads[distance] = (slopeHeads[distance] + 1) % (maxSeriesLength - distance);
+        }
+    }
+
+    seriesX.push(x);
+    seriesY.push(pointY);
+    shouldRecalculateA = true;
+    shouldRecalculateB = true;
+
+    // Calculate the slopes of this new point
+    if (seriesX.size() > 1)
+    {
+        // There are at least two points in the X and Y arrays, so let's add the new datapoint
+        const unsigned char newPoint = seriesX.size() - 1;
+        SeriesKernels::slopesToPoint(seriesX.values().first(newPoint), seriesY.values().first(newPoint), x, pointY, span<storage>(newSlopes).first(newPoint));
+        for (unsigned char i = 0; i < newPoint; ++i)
+        {
+            slopes[slopeIndex(i, newPoint)] = newSlopes[i];
+            orderedSlopes.insert(newSlopes[i]);
+        }
+    }
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+void TSLinearSeries<maxSeriesLength, TPrecision>::reset()
+{
+    seriesX.reset();
+    seriesY.reset();
+
+    slopeHeads.fill(0);
+    orderedSlopes.reset();
+
+    a = 0;
+    originX = 0;
+    pushesSinceRebase = 0;
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+size_t TSLinearSeries<maxSeriesLength, TPrecision>::size() const
+{
+    return seriesY.size();
+}
@@ -1,54 +1,323 @@
 #pragma once
 
-#include <vector>
+#include <algorithm>
+#include <array>
 
 #include "../configuration.h"
-#include "./series.h"
-
-using std::vector;
+#include "./fixed-series.h"
+#include "./median-network.h"
+#include "./precision-policy.h"
+#include "./quadratic-moment-sums.h"
+#include "./series-kernels.h"
 
+template <unsigned char maxSeriesLength, typename TPrecision = PrecisionPolicy<Configurations::precision>>
 class TSQuadraticSeries
 {
-    const unsigned char maxSeriesLength;
-    const unsigned short maxSeriesAInnerLength = ((maxSeriesLength - 2) * (maxSeriesLength - 1)) / 2;
-    const unsigned short maxSeriesALength;
-    const unsigned short maxAllocationCapacity;
+    typedef typename TPrecision::storage storage;
+    typedef typename TPrecision::compute compute;
+
+    static_assert(maxSeriesLength > 2, "TSQuadraticSeries requires at least three points");
 
-    Configurations::precision a = 0;
-    Configurations::precision b = 0;
-    Configurations::precision c = 0;
-    vector<vector<Configurations::precision>> seriesA;
-    Series seriesX;
-    Series seriesY;
+    static constexpr unsigned short maxSeriesALength = (maxSeriesLength * (maxSeriesLength - 1) * (maxSeriesLength - 2)) / 6;
+    static constexpr unsigned short maxResidueSlopeLength = (maxSeriesLength * (maxSeriesLength - 1)) / 2;
 
-    Configurations::precision calculateA(unsigned char pointOne, unsigned char pointTwo, unsigned char pointThree) const;
-    Configurations::precision seriesAMedian() const;
+    compute a = 0;
+    compute b = 0;
+    compute c = 0;
+    // The regression only covers the oldest windowLength points (the points and the triples are stored for the longest window), so a shorter window keeps the lag of the full one. The triples between the first calculatedLength points are up to date, a longer window calculates the triples of the points it takes in
+    unsigned char windowLength = maxSeriesLength;
+    unsigned char appliedWindowLength = maxSeriesLength;
+    unsigned char calculatedLength = 0;
+    // Triangular ring of the triple coefficients: triples with the same distance between their first and second point and between their first and last point form one ring (of maxSeriesLength - span slots), and these rings are stored back to back in a single contiguous array
+    std::array<storage, maxSeriesALength> seriesA{};
+    std::array<unsigned char, maxSeriesLength> seriesAHeads{};
+    std::array<storage, maxSeriesALength> seriesASelection{};
+    std::array<storage, maxSeriesLength> newSeriesA{};
+    std::array<compute, maxSeriesLength> residueY{};
+    std::array<storage, maxResidueSlopeLength> residueSelection{};
+    std::array<compute, maxSeriesLength> residueIntercepts{};
+    // The points are stored relative to an origin (the first point, then the oldest point of the window when the moment sums are rebased), so the triple coefficients are not calculated from the session long total time and angular displacement where their terms cancel. The derivatives and the goodness of fit do not depend on the origin
+    compute originX = 0;
+    compute originY = 0;
+    FixedSeries<maxSeriesLength, compute> seriesX;
+    FixedSeries<maxSeriesLength, compute> seriesY;
+    QuadraticMomentSums<maxSeriesLength, compute> momentSums;
 
-    static constexpr unsigned short calculateMaxSeriesALength(const unsigned short seriesLength, const unsigned short seriesAInnerLength)
+    // The rings of span s (there are s - 1 of them, one for each position of the middle point) start after all the rings of the shorter spans
+    static constexpr std::array<unsigned short, maxSeriesLength> seriesASpanOffsets = []()
     {
-        unsigned char baseValue = seriesAInnerLength;
-        unsigned short sum = baseValue;
-        for (unsigned char i = 0; i < seriesLength - 3; ++i)
+        std::array<unsigned short, maxSeriesLength> offsets{};
+        unsigned short offset = 0;
+        for (unsigned char span = 2; span < maxSeriesLength; ++span)
         {
-            baseValue -= seriesLength - i - 2;
-            sum += baseValue;
+            offsets[span] = offset;
+            offset += (span - 1) * (maxSeriesLength - span);
         }
-        return sum;
-    }
 
-    Configurations::precision projectX(Configurations::precision pointX) const;
+        return offsets;
+    }();
+
+    unsigned short seriesAIndex(unsigned char pointOne, unsigned char pointTwo, unsigned char pointThree) const;
+    unsigned char activeSize() const;
+    void calculateTriples(unsigned char pointOne, unsigned char pointThree);
+    void rebase();
+    compute seriesAMedian();
+    void calculateResidueCoefficients();
+    template <typename T, size_t length>
+    static T selectMedian(std::array<T, length> &values, unsigned short size);
 
 public:
-    constexpr explicit TSQuadraticSeries(const unsigned char _maxSeriesLength = 0, const unsigned short _maxAllocationCapacity = 1'000) : maxSeriesLength(_maxSeriesLength), maxSeriesALength(calculateMaxSeriesALength(_maxSeriesLength, maxSeriesAInnerLength)), maxAllocationCapacity(_maxAllocationCapacity), seriesX(_maxSeriesLength, _maxAllocationCapacity), seriesY(_maxSeriesLength, _maxAllocationCapacity)
+    compute firstDerivativeAtPosition(unsigned char position) const;
+    compute secondDerivativeAtPosition(unsigned char position) const;
+    compute goodnessOfFit() const;
+    void setWindowLength(unsigned char length);
+    void push(compute pointX, compute pointY);
+    void reset();
+};
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+typename TPrecision::compute TSQuadraticSeries<maxSeriesLength, TPrecision>::firstDerivativeAtPosition(const unsigned char position) const
+{
+    if (activeSize() < 3 || position >= seriesX.size())
+    {
+        return 0;
+    }
+
+    return a * 2 * seriesX[position] + b;
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+typename TPrecision::compute TSQuadraticSeries<maxSeriesLength, TPrecision>::secondDerivativeAtPosition(const unsigned char position) const
+{
+    if (activeSize() < 3 || position >= seriesX.size())
     {
-        if (_maxSeriesLength > 0)
+        return 0;
+    }
+
+    return a * 2;
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+void TSQuadraticSeries<maxSeriesLength, TPrecision>::setWindowLength(const unsigned char length)
+{
+    // Takes effect from the next push
+    windowLength = std::clamp(length, static_cast<unsigned char>(3), maxSeriesLength);
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+void TSQuadraticSeries<maxSeriesLength, TPrecision>::push(const compute pointX, const compute pointY)
+{
+    const auto isWindowLengthChanged = windowLength != appliedWindowLength;
+    if (seriesX.size() >= maxSeriesLength)
+    {
+        // The maximum of the array has been reached, advancing the heads of the rings drops the triples of the oldest point and frees their slots for the triples of the new point
+        for (unsigned char span = 2; span < maxSeriesLength; ++span)
         {
-            seriesA.reserve(_maxSeriesLength - 3);
+            seriesAHeads[span] = (seriesAHeads[span] + 1) % (maxSeriesLength - span);
         }
+        if (!isWindowLengthChanged)
+        {
+            momentSums.remove(seriesX[0], seriesY[0]);
+        }
+        --calculatedLength;
     }
 
-    Configurations::precision firstDerivativeAtPosition(unsigned char position) const;
-    Configurations::precision secondDerivativeAtPosition(unsigned char position) const;
-    Configurations::precision goodnessOfFit() const;
-    void push(Configurations::precision pointX, Configurations::precision pointY);
-};
+    if (seriesX.size() == 0)
+    {
+        originX = pointX;
+        originY = pointY;
+    }
+    const auto previousActiveSize = activeSize();
+    seriesX.push(pointX - originX);
+    seriesY.push(pointY - originY);
+    appliedWindowLength = windowLength;
+    const unsigned char windowSize = activeSize();
+    if (isWindowLengthChanged)
+    {
+        momentSums.rebase(seriesX.values().first(windowSize), seriesY.values().first(windowSize));
+    }
+    else if (seriesX.size() >= maxSeriesLength || windowSize > previousActiveSize)
+    {
+        // The window either moved by one point or took in the new point
+        momentSums.add(seriesX[windowSize - 1], seriesY[windowSize - 1]);
+    }
+    if (momentSums.isRebaseDue())
+    {
+        rebase();
+    }
+
+    if (windowSize < 3)
+    {
+        a = 0;
+        b = 0;
+        c = 0;
+
+        return;
+    }
+
+    // Calculate the coefficients of the points that entered the window if we have three or more points in it
+    for (auto pointThree = std::max(calculatedLength, static_cast<unsigned char>(2)); pointThree < windowSize; ++pointThree)
+    {
+        for (unsigned char pointOne = 0; pointOne < pointThree - 1U; ++pointOne)
+        {
+            calculateTriples(pointOne, pointThree);
+        }
+    }
+    calculatedLength = std::max(calculatedLength, windowSize);
+    a = seriesAMedian();
+
+    calculateResidueCoefficients();
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+void TSQuadraticSeries<maxSeriesLength, TPrecision>::calculateTriples(const unsigned char pointOne, const unsigned char pointThree)
+{
+    // The triples with the same first and last point are calculated in one pass over the middle points, then placed into their rings
+    const auto valuesX = seriesX.values();
+    const auto valuesY = seriesY.values();
+    const unsigned char middleCount = pointThree - pointOne - 1;
+    SeriesKernels::coefficientsA(valuesX[pointOne], valuesY[pointOne], valuesX.subspan(pointOne + 1, middleCount), valuesY.subspan(pointOne + 1, middleCount), valuesX[pointThree], valuesY[pointThree], span<storage>(newSeriesA).first(middleCount));
+    for (unsigned char middle = 0; middle < middleCount; ++middle)
+    {
+        seriesA[seriesAIndex(pointOne, pointOne + 1 + middle, pointThree)] = newSeriesA[middle];
+    }
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+void TSQuadraticSeries<maxSeriesLength, TPrecision>::rebase()
+{
+    // The oldest point becomes the new origin, the moment sums are recalculated from the moved window
+    const auto offsetX = seriesX[0];
+    const auto offsetY = seriesY[0];
+    seriesX.shift(offsetX);
+    seriesY.shift(offsetY);
+    originX += offsetX;
+    originY += offsetY;
+    momentSums.rebase(seriesX.values().first(activeSize()), seriesY.values().first(activeSize()));
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+void TSQuadraticSeries<maxSeriesLength, TPrecision>::calculateResidueCoefficients()
+{
+    // B and C are the Theil-Sen linear fit of the residue (y - a * x^2), i.e. the median of the pairwise residue slopes and the median of the intercepts at that slope. The fit is done in fixed size scratch arrays so it does not allocate
+    const unsigned char seriesSize = activeSize();
+    const auto valuesX = seriesX.values();
+    const auto valuesY = seriesY.values();
+    auto i = 0U;
+    while (i < seriesSize)
+    {
+        residueY[i] = valuesY[i] - a * (valuesX[i] * valuesX[i]);
+        ++i;
+    }
+
+    const span<const compute> residues(residueY.data(), seriesSize);
+    unsigned short selectionSize = 0;
+    i = 0;
+    while (i < seriesSize - 1U)
+    {
+        const unsigned char laterCount = seriesSize - i - 1;
+        SeriesKernels::slopesFromPoint(valuesX[i], residues[i], valuesX.subspan(i + 1, laterCount), residues.subspan(i + 1, laterCount), span<storage>(residueSelection).subspan(selectionSize, laterCount));
+        selectionSize += laterCount;
+        ++i;
+    }
+    b = selectMedian(residueSelection, selectionSize);
+
+    selectionSize = 0;
+    i = 0;
+    while (i < seriesSize - 1U)
+    {
+        residueIntercepts[selectionSize] = residueY[i] - (b * valuesX[i]);
+        ++selectionSize;
+        ++i;
+    }
+    c = selectMedian(residueIntercepts, selectionSize);
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+unsigned char TSQuadraticSeries<maxSeriesLength, TPrecision>::activeSize() const
+{
+    return std::min<unsigned char>(seriesX.size(), appliedWindowLength);
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+unsigned short TSQuadraticSeries<maxSeriesLength, TPrecision>::seriesAIndex(const unsigned char pointOne, const unsigned char pointTwo, const unsigned char pointThree) const
+{
+    const unsigned char span = pointThree - pointOne;
+    const unsigned char ringLength = maxSeriesLength - span;
+
+    return seriesASpanOffsets[span] + (pointTwo - pointOne - 1) * ringLength + (seriesAHeads[span] + pointOne) % ringLength;
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+typename TPrecision::compute TSQuadraticSeries<maxSeriesLength, TPrecision>::seriesAMedian()
+{
+    // The median selection reorders its input so the median is selected from a copy of the rings. Until the window fills up the rings have not wrapped, so only the first (series size - span) slots of each ring are used. A shorter window uses the (window size - span) slots from the head, which may wrap around the end of the ring
+    if (activeSize() == maxSeriesLength)
+    {
+        seriesASelection = seriesA;
+
+        return selectMedian(seriesASelection, maxSeriesALength);
+    }
+
+    const unsigned char windowSize = activeSize();
+    unsigned short selectionSize = 0;
+    for (unsigned char span = 2; span < windowSize; ++span)
+    {
+        const unsigned char ringLength = maxSeriesLength - span;
+        const unsigned char usedLength = windowSize - span;
+        const unsigned char usedBegin = seriesAHeads[span];
+        const unsigned char firstLength = std::min(usedLength, static_cast<unsigned char>(ringLength - usedBegin));
+        for (unsigned char middle = 0; middle < span - 1; ++middle)
+        {
+            const auto ringBegin = cbegin(seriesA) + seriesASpanOffsets[span] + middle * ringLength;
+            std::copy(ringBegin + usedBegin, ringBegin + usedBegin + firstLength, begin(seriesASelection) + selectionSize);
+            std::copy(ringBegin, ringBegin + (usedLength - firstLength), begin(seriesASelection) + selectionSize + firstLength);
+            selectionSize += usedLength;
+        }
+    }
+
+    return selectMedian(seriesASelection, selectionSize);
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+template <typename T, size_t length>
+T TSQuadraticSeries<maxSeriesLength, TPrecision>::selectMedian(std::array<T, length> &values, const unsigned short size)
+{
+    // A full selection array has a compile time size so its network is inlined, a partially filled one (until the window fills up) looks it up by size
+    if (size == length)
+    {
+        return MedianNetwork::select<length>(values.data());
+    }
+
+    return MedianNetwork::select(span<T>(values.data(), size));
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+typename TPrecision::compute TSQuadraticSeries<maxSeriesLength, TPrecision>::goodnessOfFit() const
+{
+    // This function returns the R^2 as a goodness of fit indicator, calculated in O(1) from the moment sums of the window
+    if (activeSize() < 3)
+    {
+        return 0.0;
+    }
+
+    return momentSums.goodnessOfFit(a, b, c);
+}
+
+template <unsigned char maxSeriesLength, typename TPrecision>
+void TSQuadraticSeries<maxSeriesLength, TPrecision>::reset()
+{
+    seriesX.reset();
+    seriesY.reset();
+    momentSums.reset();
+
+    seriesAHeads.fill(0);
+    appliedWindowLength = windowLength;
+    calculatedLength = 0;
+
+    a = 0;
+    b = 0;
+    c = 0;
+    originX = 0;
+    originY = 0;
+}
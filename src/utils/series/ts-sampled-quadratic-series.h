@@ -0,0 +1,282 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+
+#include "../configuration.h"
+#include "./fixed-series.h"
+#include "./median-network.h"
+#include "./order-statistic-pool.h"
+#include "./precision-policy.h"
+#include "./quadratic-moment-sums.h"
+#include "./series-kernels.h"
+
+// Bounded cost variant of TSQuadraticSeries for large windows: instead of every triple of the window only the triples of at most maxTriplesPerPoint patterns are used, a pattern being the distance of the middle and the last point from the first one (i.e. the triples (i, i + middle, i + span)). So each new point adds at most maxTriplesPerPoint triples (and evicts as many), the median of the triples is kept in an ordered pool, and B and C are fitted on the pairs that are half a window apart. A push is therefore O(maxTriplesPerPoint * log) + O(N) instead of O(N^2) + O(N^3). With a budget of at least (N - 1) * (N - 2) / 2 every pattern (so every triple of the window) is used and A is the same as the exact estimator's
+template <unsigned char maxSeriesLength, unsigned char maxTriplesPerPoint, typename TPrecision = PrecisionPolicy<Configurations::precision>>
+class TSSampledQuadraticSeries
+{
+    static_assert(maxSeriesLength > 2, "TSSampledQuadraticSeries requires at least three points");
+    static_assert(maxTriplesPerPoint > 0, "TSSampledQuadraticSeries requires at least one triple per point");
+
+    typedef typename TPrecision::storage storage;
+    typedef typename TPrecision::compute compute;
+
+    struct Pattern
+    {
+        unsigned char span = 0;
+        unsigned char middle = 0;
+    };
+
+    static constexpr unsigned short allPatternCount = ((maxSeriesLength - 1) * (maxSeriesLength - 2)) / 2;
+    static constexpr unsigned short patternCount = std::min<unsigned short>(allPatternCount, maxTriplesPerPoint);
+
+    // The equally spaced patterns (i, i + gap, i + 2 * gap) come first with gaps spread evenly between 1 and (N - 1) / 2 (a single gap uses the widest one), as these are the best conditioned triples and represent both the local and the window wide curvature. The rest of the budget is stratified evenly over the remaining patterns (ordered by span then middle) so no region of the window is left out
+    static constexpr std::array<Pattern, patternCount> patterns = []()
+    {
+        constexpr unsigned char maxGap = (maxSeriesLength - 1) / 2;
+        constexpr unsigned short gapCount = std::min<unsigned short>(maxGap, patternCount);
+
+        std::array<Pattern, patternCount> patterns{};
+        unsigned short count = 0;
+        for (unsigned short gapIndex = 0; gapIndex < gapCount; ++gapIndex)
+        {
+            const unsigned char gap = gapCount == 1 ? maxGap : 1 + (gapIndex * (maxGap - 1)) / (gapCount - 1);
+            patterns[count++] = {static_cast<unsigned char>(2 * gap), gap};
+        }
+
+        std::array<Pattern, allPatternCount> remainingPatterns{};
+        unsigned short remainingCount = 0;
+        for (unsigned char span = 2; span < maxSeriesLength; ++span)
+        {
+            for (unsigned char middle = 1; middle < span; ++middle)
+            {
+                if (std::none_of(patterns.begin(), patterns.begin() + gapCount, [span, middle](const Pattern pattern)
+                                 { return pattern.span == span && pattern.middle == middle; }))
+                {
+                    remainingPatterns[remainingCount++] = {span, middle};
+                }
+            }
+        }
+
+        const unsigned short extraCount = patternCount - gapCount;
+        for (unsigned short i = 0; i < extraCount; ++i)
+        {
+            patterns[count++] = remainingPatterns[((2 * i + 1) * remainingCount) / (2 * extraCount)];
+        }
+
+        return patterns;
+    }();
+
+    // The triples of one pattern form a ring (of maxSeriesLength - span slots), these rings are stored back to back in a single contiguous array
+    static constexpr std::array<unsigned short, patternCount + 1> seriesAPatternOffsets = []()
+    {
+        std::array<unsigned short, patternCount + 1> offsets{};
+        for (unsigned short patternIndex = 0; patternIndex < patternCount; ++patternIndex)
+        {
+            offsets[patternIndex + 1] = offsets[patternIndex] + maxSeriesLength - patterns[patternIndex].span;
+        }
+
+        return offsets;
+    }();
+    static constexpr unsigned short maxSeriesALength = seriesAPatternOffsets[patternCount];
+
+    compute a = 0;
+    compute b = 0;
+    compute c = 0;
+    std::array<storage, maxSeriesALength> seriesA{};
+    std::array<unsigned char, patternCount> seriesAHeads{};
+    OrderStatisticPool<storage> orderedSeriesA = OrderStatisticPool<storage>(maxSeriesALength);
+    std::array<compute, maxSeriesLength> residueY{};
+    std::array<storage, maxSeriesLength> residueSelection{};
+    std::array<compute, maxSeriesLength> residueIntercepts{};
+    // Same window relative coordinates as TSQuadraticSeries (the origin moves to the oldest point whenever the moment sums are rebased)
+    compute originX = 0;
+    compute originY = 0;
+    FixedSeries<maxSeriesLength, compute> seriesX;
+    FixedSeries<maxSeriesLength, compute> seriesY;
+    QuadraticMomentSums<maxSeriesLength, compute> momentSums;
+
+    unsigned short seriesAIndex(unsigned short patternIndex, unsigned char pointOne) const;
+    void rebase();
+    void calculateResidueCoefficients();
+    template <typename T, size_t length>
+    static T selectMedian(std::array<T, length> &values, unsigned short size);
+
+public:
+    compute firstDerivativeAtPosition(unsigned char position) const;
+    compute secondDerivativeAtPosition(unsigned char position) const;
+    compute goodnessOfFit() const;
+    void push(compute pointX, compute pointY);
+    void reset();
+};
+
+template <unsigned char maxSeriesLength, unsigned char maxTriplesPerPoint, typename TPrecision>
+typename TPrecision::compute TSSampledQuadraticSeries<maxSeriesLength, maxTriplesPerPoint, TPrecision>::firstDerivativeAtPosition(const unsigned char position) const
+{
+    if (seriesX.size() < 3 || position >= seriesX.size())
+    {
+        return 0;
+    }
+
+    return a * 2 * seriesX[position] + b;
+}
+
+template <unsigned char maxSeriesLength, unsigned char maxTriplesPerPoint, typename TPrecision>
+typename TPrecision::compute TSSampledQuadraticSeries<maxSeriesLength, maxTriplesPerPoint, TPrecision>::secondDerivativeAtPosition(const unsigned char position) const
+{
+    if (seriesX.size() < 3 || position >= seriesX.size())
+    {
+        return 0;
+    }
+
+    return a * 2;
+}
+
+template <unsigned char maxSeriesLength, unsigned char maxTriplesPerPoint, typename TPrecision>
+void TSSampledQuadraticSeries<maxSeriesLength, maxTriplesPerPoint, TPrecision>::push(const compute pointX, const compute pointY)
+{
+    if (seriesX.size() >= maxSeriesLength)
+    {
+        // The maximum of the array has been reached, the triples starting at the oldest point are at the heads of the rings, these are removed from the ordered pool and their slots are reused by the triples of the new point
+        for (unsigned short patternIndex = 0; patternIndex < patternCount; ++patternIndex)
+        {
+            orderedSeriesA.erase(seriesA[seriesAIndex(patternIndex, 0)]);
+            seriesAHeads[patternIndex] = (seriesAHeads[patternIndex] + 1) % (maxSeriesLength - patterns[patternIndex].span);
+        }
+    }
+
+    if (seriesX.size() == 0)
+    {
+        originX = pointX;
+        originY = pointY;
+    }
+    if (seriesX.size() >= maxSeriesLength)
+    {
+        momentSums.remove(seriesX[0], seriesY[0]);
+    }
+    seriesX.push(pointX - originX);
+    seriesY.push(pointY - originY);
+    momentSums.add(seriesX[seriesX.size() - 1], seriesY[seriesY.size() - 1]);
+    if (momentSums.isRebaseDue())
+    {
+        rebase();
+    }
+
+    if (seriesX.size() < 3)
+    {
+        a = 0;
+        b = 0;
+        c = 0;
+
+        return;
+    }
+
+    const unsigned char newPoint = seriesX.size() - 1;
+    for (unsigned short patternIndex = 0; patternIndex < patternCount; ++patternIndex)
+    {
+        const auto pattern = patterns[patternIndex];
+        if (pattern.span > newPoint)
+        {
+            continue;
+        }
+        const unsigned char pointOne = newPoint - pattern.span;
+        const unsigned char pointTwo = pointOne + pattern.middle;
+        const auto result = static_cast<storage>(SeriesKernels::coefficientA(seriesX[pointOne], seriesY[pointOne], seriesX[pointTwo], seriesY[pointTwo], seriesX[newPoint], seriesY[newPoint]));
+        seriesA[seriesAIndex(patternIndex, pointOne)] = result;
+        orderedSeriesA.insert(result);
+    }
+    a = static_cast<compute>(orderedSeriesA.median());
+
+    calculateResidueCoefficients();
+}
+
+template <unsigned char maxSeriesLength, unsigned char maxTriplesPerPoint, typename TPrecision>
+void TSSampledQuadraticSeries<maxSeriesLength, maxTriplesPerPoint, TPrecision>::rebase()
+{
+    const auto offsetX = seriesX[0];
+    const auto offsetY = seriesY[0];
+    seriesX.shift(offsetX);
+    seriesY.shift(offsetY);
+    originX += offsetX;
+    originY += offsetY;
+    momentSums.rebase(seriesX.values(), seriesY.values());
+}
+
+template <unsigned char maxSeriesLength, unsigned char maxTriplesPerPoint, typename TPrecision>
+void TSSampledQuadraticSeries<maxSeriesLength, maxTriplesPerPoint, TPrecision>::calculateResidueCoefficients()
+{
+    // B and C are the Theil-Sen linear fit of the residue (y - a * x^2) over the pairs that are half a window apart (these have the widest baselines while each point is used at most twice)
+    const unsigned char seriesSize = seriesX.size();
+    const auto valuesX = seriesX.values();
+    const auto valuesY = seriesY.values();
+    auto i = 0U;
+    while (i < seriesSize)
+    {
+        residueY[i] = valuesY[i] - a * (valuesX[i] * valuesX[i]);
+        ++i;
+    }
+
+    const span<const compute> residues(residueY.data(), seriesSize);
+    const unsigned char distance = seriesSize / 2;
+    const unsigned char pairCount = seriesSize - distance;
+    SeriesKernels::slopesBetween(valuesX.first(pairCount), residues.first(pairCount), valuesX.subspan(distance, pairCount), residues.subspan(distance, pairCount), span<storage>(residueSelection).first(pairCount));
+    b = static_cast<compute>(selectMedian(residueSelection, pairCount));
+
+    i = 0;
+    while (i < seriesSize)
+    {
+        residueIntercepts[i] = residueY[i] - (b * valuesX[i]);
+        ++i;
+    }
+    c = selectMedian(residueIntercepts, seriesSize);
+}
+
+template <unsigned char maxSeriesLength, unsigned char maxTriplesPerPoint, typename TPrecision>
+unsigned short TSSampledQuadraticSeries<maxSeriesLength, maxTriplesPerPoint, TPrecision>::seriesAIndex(const unsigned short patternIndex, const unsigned char pointOne) const
+{
+    const unsigned char ringLength = maxSeriesLength - patterns[patternIndex].span;
+
+    return seriesAPatternOffsets[patternIndex] + (seriesAHeads[patternIndex] + pointOne) % ringLength;
+}
+
+template <unsigned char maxSeriesLength, unsigned char maxTriplesPerPoint, typename TPrecision>
+template <typename T, size_t length>
+T TSSampledQuadraticSeries<maxSeriesLength, maxTriplesPerPoint, TPrecision>::selectMedian(std::array<T, length> &values, const unsigned short size)
+{
+    // A full selection array has a compile time size so its network is inlined, a partially filled one (until the window fills up) looks it up by size
+    if (size == length)
+    {
+        return MedianNetwork::select<length>(values.data());
+    }
+
+    return MedianNetwork::select(span<T>(values.data(), size));
+}
+
+template <unsigned char maxSeriesLength, unsigned char maxTriplesPerPoint, typename TPrecision>
+typename TPrecision::compute TSSampledQuadraticSeries<maxSeriesLength, maxTriplesPerPoint, TPrecision>::goodnessOfFit() const
+{
+    // This function returns the R^2 as a goodness of fit indicator, calculated in O(1) from the moment sums of the window
+    if (seriesX.size() < 3)
+    {
+        return 0.0;
+    }
+
+    return momentSums.goodnessOfFit(a, b, c);
+}
+
+template <unsigned char maxSeriesLength, unsigned char maxTriplesPerPoint, typename TPrecision>
+void TSSampledQuadraticSeries<maxSeriesLength, maxTriplesPerPoint, TPrecision>::reset()
+{
+    seriesX.reset();
+    seriesY.reset();
+    momentSums.reset();
+
+    seriesAHeads.fill(0);
+    orderedSeriesA.reset();
+
+    a = 0;
+    b = 0;
+    c = 0;
+    originX = 0;
+    originY = 0;
+}
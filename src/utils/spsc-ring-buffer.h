@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+// Lock-free single producer single consumer ring buffer for handing values from an interrupt to the main loop without masking the interrupt. The producer only writes the tail and the consumer only writes the head (both are free running counters, so capacity must be a power of two), and the release/acquire pairs make sure a value is fully written before the consumer can see it. When the ring is full the new value is dropped and counted instead of overwriting values the consumer may be reading
+template <typename T, unsigned int capacity>
+class SpscRingBuffer
+{
+    static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0, "SpscRingBuffer capacity must be a power of two");
+
+    std::array<T, capacity> buffer{};
+    std::atomic<unsigned int> head{0};
+    std::atomic<unsigned int> tail{0};
+    std::atomic<unsigned long> overflowCount{0};
+
+public:
+    bool push(T value);
+    bool pop(T &value);
+
+    bool isEmpty() const;
+    unsigned int size() const;
+    unsigned long getOverflowCount() const;
+};
+
+template <typename T, unsigned int capacity>
+bool SpscRingBuffer<T, capacity>::push(const T value)
+{
+    const auto currentTail = tail.load(std::memory_order_relaxed);
+    if (currentTail - head.load(std::memory_order_acquire) >= capacity)
+    {
+        overflowCount.store(overflowCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        return false;
+    }
+
+    buffer[currentTail & (capacity - 1)] = value;
+    tail.store(currentTail + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <typename T, unsigned int capacity>
+bool SpscRingBuffer<T, capacity>::pop(T &value)
+{
+    const auto currentHead = head.load(std::memory_order_relaxed);
+    if (currentHead == tail.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    value = buffer[currentHead & (capacity - 1)];
+    head.store(currentHead + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <typename T, unsigned int capacity>
+bool SpscRingBuffer<T, capacity>::isEmpty() const
+{
+    return head.load(std::memory_order_relaxed) == tail.load(std::memory_order_acquire);
+}
+
+template <typename T, unsigned int capacity>
+unsigned int SpscRingBuffer<T, capacity>::size() const
+{
+    return tail.load(std::memory_order_acquire) - head.load(std::memory_order_relaxed);
+}
+
+template <typename T, unsigned int capacity>
+unsigned long SpscRingBuffer<T, capacity>::getOverflowCount() const
+{
+    return overflowCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <bit>
+
+// Fixed bucket, log scale histogram of durations in microseconds: bucket 0 counts zero durations, bucket i counts durations of at least 2^(i-1) and below 2^i microseconds and the last bucket collects everything longer. Recording is O(1) and never allocates so it can run on every impulse
+template <unsigned char bucketCount>
+class TimingHistogram
+{
+    static_assert(bucketCount > 1, "TimingHistogram requires at least two buckets");
+
+    std::array<unsigned long, bucketCount> buckets{};
+    unsigned long count = 0UL;
+    unsigned long maxTime = 0UL;
+
+public:
+    static constexpr unsigned char size();
+    static constexpr unsigned char bucketIndex(unsigned long time);
+
+    void record(unsigned long time);
+    void reset();
+
+    unsigned long getBucket(unsigned char index) const;
+    unsigned long getCount() const;
+    unsigned long getMaxTime() const;
+};
+
+template <unsigned char bucketCount>
+constexpr unsigned char TimingHistogram<bucketCount>::size()
+{
+    return bucketCount;
+}
+
+template <unsigned char bucketCount>
+constexpr unsigned char TimingHistogram<bucketCount>::bucketIndex(const unsigned long time)
+{
+    const auto index = std::bit_width(time);
+
+    return index < bucketCount ? index : bucketCount - 1;
+}
+
+template <unsigned char bucketCount>
+void TimingHistogram<bucketCount>::record(const unsigned long time)
+{
+    ++buckets[bucketIndex(time)];
+    ++count;
+    if (time > maxTime)
+    {
+        maxTime = time;
+    }
+}
+
+template <unsigned char bucketCount>
+void TimingHistogram<bucketCount>::reset()
+{
+    buckets.fill(0UL);
+    count = 0UL;
+    maxTime = 0UL;
+}
+
+template <unsigned char bucketCount>
+unsigned long TimingHistogram<bucketCount>::getBucket(const unsigned char index) const
+{
+    return index < bucketCount ? buckets[index] : 0UL;
+}
+
+template <unsigned char bucketCount>
+unsigned long TimingHistogram<bucketCount>::getCount() const
+{
+    return count;
+}
+
+template <unsigned char bucketCount>
+unsigned long TimingHistogram<bucketCount>::getMaxTime() const
+{
+    return maxTime;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+// Triple buffer for handing a value from one writer task to one reader task without locking or copying. The writer prepares the back buffer in place and publishes it by exchanging it with the middle buffer, the reader acquires the last published value by exchanging its front buffer with the middle one. Neither side ever touches the buffer the other one owns, so a reference to the front buffer stays consistent until the reader itself acquires again, regardless of how often the writer publishes in the meantime
+template <typename T>
+class TripleBuffer
+{
+    // The middle index carries a flag telling the reader whether the writer published since the last acquire
+    static constexpr unsigned char indexMask = 0x03U;
+    static constexpr unsigned char publishedFlag = 0x04U;
+
+    std::array<T, 3> buffers{};
+    unsigned char backIndex = 0U;
+    std::atomic<unsigned char> middleIndex{1U};
+    unsigned char frontIndex = 2U;
+
+public:
+    TripleBuffer() = default;
+    template <typename Initializer>
+    explicit TripleBuffer(Initializer initializer);
+
+    T &back();
+    void publish();
+
+    bool acquire();
+    const T &front() const;
+};
+
+template <typename T>
+template <typename Initializer>
+TripleBuffer<T>::TripleBuffer(Initializer initializer)
+{
+    for (auto &buffer : buffers)
+    {
+        initializer(buffer);
+    }
+}
+
+template <typename T>
+T &TripleBuffer<T>::back()
+{
+    return buffers[backIndex];
+}
+
+template <typename T>
+void TripleBuffer<T>::publish()
+{
+    // The release hands the writes to the back buffer over with it, the acquire takes over the buffer the reader released last
+    backIndex = middleIndex.exchange(backIndex | publishedFlag, std::memory_order_acq_rel) & indexMask;
+}
+
+template <typename T>
+bool TripleBuffer<T>::acquire()
+{
+    if ((middleIndex.load(std::memory_order_relaxed) & publishedFlag) == 0U)
+    {
+        return false;
+    }
+
+    frontIndex = middleIndex.exchange(frontIndex, std::memory_order_acq_rel) & indexMask;
+
+    return true;
+}
+
+template <typename T>
+const T &TripleBuffer<T>::front() const
+{
+    return buffers[frontIndex];
+}
@@ -1,9 +1,16 @@
 // NOLINTBEGIN
 #pragma once
+#include <chrono>
 #include <climits>
 
 #include "./Esp32-typedefs.h"
 
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef unsigned int TickType_t;
+typedef void (*TaskFunction_t)(void *);
+typedef void *TaskHandle_t;
+
 #define INPUT 0x01
 #define OUTPUT 0x03
 #define INPUT_PULLUP 0x05
@@ -11,11 +18,17 @@
 #define HIGH 0x01
 #define PI 3.1415926535897932384626433832795
 #define LED_BUILTIN GPIO_NUM_2
+#define IRAM_ATTR
+#define pdFALSE 0
+#define pdTRUE 1
+#define portMAX_DELAY (TickType_t)0xffffffffUL
+#define portYIELD_FROM_ISR(xHigherPriorityTaskWoken)
 
 inline unsigned long analogReadMilliVolts(unsigned char pin) { return 0; };
 inline void pinMode(unsigned char pin, unsigned char mode) {}
 inline void digitalWrite(unsigned char pin, unsigned char val) {}
-inline unsigned long micros() { return 0; }
+// Wall clock time so the engine diagnostics measure the real execution time of the stroke engine on the host
+inline unsigned long micros() { return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()); }
 inline int digitalRead(unsigned char pin) { return 0; }
 inline void gpio_hold_en(gpio_num_t gpio_num) {}
 inline unsigned short analogRead(unsigned char pin) { return 0; }
@@ -23,4 +36,9 @@ inline void delay(unsigned int) {}
 inline esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause() { return ESP_SLEEP_WAKEUP_EXT1; }
 inline void esp_sleep_enable_ext0_wakeup(gpio_num_t gpio_num, int level) {}
 inline void esp_deep_sleep_start() {}
+// There is no scheduler in the e2e tests: tasks are never started and the stroke engine runs in line from the loop
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode, const char *const pcName, const unsigned int usStackDepth, void *const pvParameters, UBaseType_t uxPriority, TaskHandle_t *const pvCreatedTask, const BaseType_t xCoreID) { return pdFALSE; }
+inline void vTaskDelete(TaskHandle_t xTaskToDelete) {}
+inline unsigned int ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait) { return 0; }
+inline void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken) {}
 // NOLINTEND
\ No newline at end of file
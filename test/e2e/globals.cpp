@@ -6,8 +6,20 @@
 
 fakeit::Mock<IEEPROMService> mockEEPROMService;
 
+// The adaptive window is timed with a simulated clock that advances by the processing time of the current window length on every reading (once at the start and once at the end of each impulse), so the window lengths it picks (and the simulation results) do not depend on the speed of the host. The processing time is proportional to the number of triples of the window (the cost of the Theil-Sen regression), which makes a full window overrun on the faster impulses of every profile while a shorter one leaves enough headroom on the slower ones to grow back
+const unsigned long simulatedProcessingTimePerTriple = 250UL;
+unsigned long simulatedProcessingClock()
+{
+    static unsigned long now = 0UL;
+    const unsigned long windowLength = strokeService.getAngularWindowLength();
+    now += simulatedProcessingTimePerTriple * windowLength * (windowLength - 1) * (windowLength - 2) / 6;
+
+    return now;
+}
+
+MetricsEventBus metricsEventBus;
 FlywheelService flywheelService;
-StrokeService strokeService;
+StrokeService strokeService(metricsEventBus, simulatedProcessingClock);
 StrokeController strokeController(strokeService, flywheelService, mockEEPROMService.get());
 
 void attachRotationInterrupt()
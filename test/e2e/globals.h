@@ -4,6 +4,7 @@
 #include "../../src/rower/stroke.controller.h"
 #include "../../src/rower/stroke.service.h"
 
+extern MetricsEventBus metricsEventBus;
 extern FlywheelService flywheelService;
 extern StrokeService strokeService;
 extern StrokeController strokeController;
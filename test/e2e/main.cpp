@@ -1,3 +1,4 @@
+#include <array>
 #include <fstream>
 #include <numeric>
 #include <span>
@@ -9,10 +10,18 @@
 
 #include "./test.array.h"
 
+unsigned long previousRawImpulseCount = 0;
+
 void loop(const unsigned long now)
 {
     simulateRotation(now);
     strokeController.update();
+    if (strokeController.getRawImpulseCount() != previousRawImpulseCount)
+    {
+        Log.traceln("deltaTime: %u", strokeController.getDeltaTime());
+        previousRawImpulseCount = strokeController.getRawImpulseCount();
+    }
+
     if (strokeController.getRevCount() != strokeController.getPreviousRevCount())
     {
         Log.infoln("distance: %f", strokeController.getDistance() / 100.0);
@@ -30,6 +39,27 @@ void loop(const unsigned long now)
     }
 }
 
+void printEngineDiagnostics()
+{
+    if constexpr (Configurations::enableEngineDiagnostics)
+    {
+        const auto diagnostics = strokeController.getDiagnostics();
+        const std::array<const char *, EngineDiagnostics::stageCount> stageNames = {"deltaTimeRegression", "angularRegression", "phaseStateMachine", "total"};
+
+        printf("engine overruns: %lu\n", diagnostics.getOverrunCount());
+        for (unsigned char stage = 0; stage < EngineDiagnostics::stageCount; ++stage)
+        {
+            const auto &histogram = diagnostics.getHistogram(static_cast<EngineStage>(stage));
+            printf("%s (count: %lu, max: %luus):", stageNames[stage], histogram.getCount(), histogram.getMaxTime());
+            for (unsigned char bucket = 0; bucket < EngineDiagnostics::bucketCount; ++bucket)
+            {
+                printf(" %lu", histogram.getBucket(bucket));
+            }
+            printf("\n");
+        }
+    }
+}
+
 int main(int argc, const char *argv[])
 {
     const auto args = std::span(argv + 1, size_t(argc - 1));
@@ -43,6 +73,8 @@ int main(int argc, const char *argv[])
             loop(now);
         }
 
+        printEngineDiagnostics();
+
         return 0;
     }
 
@@ -78,6 +110,8 @@ int main(int argc, const char *argv[])
             }
         }
 
+        printEngineDiagnostics();
+
         return 0;
     }
 
@@ -91,5 +125,7 @@ int main(int argc, const char *argv[])
         loop(now);
     }
 
+    printEngineDiagnostics();
+
     return 0;
 }
@@ -0,0 +1,121 @@
+// NOLINTBEGIN(readability-magic-numbers)
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../../src/utils/event-bus.h"
+
+enum class TestEventType : unsigned char
+{
+    First,
+    Second,
+    Third
+};
+
+struct TestEvent
+{
+    TestEventType type;
+    unsigned int value;
+};
+
+static std::vector<TestEvent> firstHandlerEvents;
+static std::vector<TestEvent> secondHandlerEvents;
+
+TEST_CASE("EventBus")
+{
+    firstHandlerEvents.clear();
+    secondHandlerEvents.clear();
+    const auto firstHandler = [](const TestEvent &event)
+    { firstHandlerEvents.push_back(event); };
+    const auto secondHandler = [](const TestEvent &event)
+    { secondHandlerEvents.push_back(event); };
+
+    SECTION("should only queue the event types a subscriber subscribed to")
+    {
+        EventBus<TestEvent, 2, 4> eventBus;
+        const auto firstId = eventBus.subscribe(firstHandler, {TestEventType::First, TestEventType::Third});
+        const auto secondId = eventBus.subscribe(secondHandler, {TestEventType::Second});
+
+        eventBus.publish({TestEventType::First, 1});
+        eventBus.publish({TestEventType::Second, 2});
+        eventBus.publish({TestEventType::Third, 3});
+
+        REQUIRE(eventBus.getBacklog(firstId) == 2);
+        REQUIRE(eventBus.getBacklog(secondId) == 1);
+    }
+
+    SECTION("should not run the handlers until dispatched")
+    {
+        EventBus<TestEvent, 2, 4> eventBus;
+        eventBus.subscribe(firstHandler, {TestEventType::First});
+
+        eventBus.publish({TestEventType::First, 1});
+
+        REQUIRE(firstHandlerEvents.empty());
+    }
+
+    SECTION("should dispatch the queued events in order and only to the given subscriber")
+    {
+        EventBus<TestEvent, 2, 4> eventBus;
+        const auto firstId = eventBus.subscribe(firstHandler, {TestEventType::First, TestEventType::Second});
+        const auto secondId = eventBus.subscribe(secondHandler, {TestEventType::Second});
+
+        eventBus.publish({TestEventType::First, 1});
+        eventBus.publish({TestEventType::Second, 2});
+
+        REQUIRE(eventBus.dispatch(firstId) == 2);
+        REQUIRE(firstHandlerEvents.size() == 2);
+        CHECK(firstHandlerEvents[0].value == 1);
+        CHECK(firstHandlerEvents[1].value == 2);
+        REQUIRE(secondHandlerEvents.empty());
+        REQUIRE(eventBus.getBacklog(firstId) == 0);
+        REQUIRE(eventBus.getBacklog(secondId) == 1);
+
+        REQUIRE(eventBus.dispatch(firstId) == 0);
+    }
+
+    SECTION("should dispatch every subscriber")
+    {
+        EventBus<TestEvent, 2, 4> eventBus;
+        eventBus.subscribe(firstHandler, {TestEventType::First});
+        eventBus.subscribe(secondHandler, {TestEventType::First});
+
+        eventBus.publish({TestEventType::First, 1});
+        eventBus.dispatchAll();
+
+        REQUIRE(firstHandlerEvents.size() == 1);
+        REQUIRE(secondHandlerEvents.size() == 1);
+    }
+
+    SECTION("should track the worst case backlog and the dropped events of a subscriber")
+    {
+        EventBus<TestEvent, 2, 4> eventBus;
+        const auto firstId = eventBus.subscribe(firstHandler, {TestEventType::First});
+
+        for (auto i = 0U; i < 6; ++i)
+        {
+            eventBus.publish({TestEventType::First, i});
+        }
+        eventBus.dispatch(firstId);
+
+        REQUIRE(firstHandlerEvents.size() == 4);
+        CHECK(firstHandlerEvents.back().value == 3);
+        REQUIRE(eventBus.getBacklog(firstId) == 0);
+        REQUIRE(eventBus.getMaxBacklog(firstId) == 4);
+        REQUIRE(eventBus.getDroppedEventCount(firstId) == 2);
+    }
+
+    SECTION("should refuse subscribers beyond its capacity")
+    {
+        EventBus<TestEvent, 1, 4> eventBus;
+        eventBus.subscribe(firstHandler, {TestEventType::First});
+
+        REQUIRE(eventBus.subscribe(secondHandler, {TestEventType::First}) == 1);
+
+        eventBus.publish({TestEventType::First, 1});
+        eventBus.dispatchAll();
+
+        REQUIRE(secondHandlerEvents.empty());
+    }
+}
+// NOLINTEND(readability-magic-numbers)
@@ -11,6 +11,7 @@ typedef int BaseType_t;
 typedef unsigned int UBaseType_t;
 typedef void (*TaskFunction_t)(void *);
 typedef void *TaskHandle_t;
+typedef unsigned int TickType_t;
 typedef void (*voidFuncPtr)(void);
 
 struct hw_timer_t;
@@ -24,6 +25,10 @@ struct hw_timer_t;
 #define PI 3.1415926535897932384626433832795
 #define LED_BUILTIN GPIO_NUM_2
 #define IRAM_ATTR
+#define pdFALSE 0
+#define pdTRUE 1
+#define portMAX_DELAY (TickType_t)0xffffffffUL
+#define portYIELD_FROM_ISR(xHigherPriorityTaskWoken)
 
 class Print
 {
@@ -61,6 +66,8 @@ public:
                                                TaskHandle_t *const pvCreatedTask,
                                                const BaseType_t xCoreID) = 0;
     virtual void vTaskDelete(TaskHandle_t xTaskToDelete) = 0;
+    virtual unsigned int ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait) = 0;
+    virtual void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken) = 0;
 };
 
 extern fakeit::Mock<MockArduino> mockArduino;
@@ -127,6 +134,16 @@ inline void vTaskDelete(TaskHandle_t xTaskToDelete)
     mockArduino.get().vTaskDelete(xTaskToDelete);
 }
 
+inline unsigned int ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+    return mockArduino.get().ulTaskNotifyTake(xClearCountOnExit, xTicksToWait);
+}
+
+inline void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    mockArduino.get().vTaskNotifyGiveFromISR(xTaskToNotify, pxHigherPriorityTaskWoken);
+}
+
 inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode,
                                           const char *const pcName,
                                           const uint32_t usStackDepth,
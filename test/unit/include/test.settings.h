@@ -45,5 +45,7 @@
 #define MINIMUM_DRIVE_TIME 300
 #define IMPULSE_DATA_ARRAY_LENGTH 7
 // #define FLOATING_POINT_PRECISION PRECISION_DOUBLE
+// #define DELTA_TIME_ARITHMETIC ARITHMETIC_FIXED_POINT
+// #define ANGULAR_ESTIMATOR ESTIMATOR_SAMPLED_THEIL_SEN
 
 // NOLINTEND(cppcoreguidelines-macro-usage)
\ No newline at end of file
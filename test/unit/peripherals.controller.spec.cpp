@@ -97,6 +97,17 @@ TEST_CASE("PeripheralController", "[peripheral]")
         Verify(Method(mockBluetoothController, notifyBattery).Using(Eq(expectedBatteryLevel))).Once();
     }
 
+    SECTION("updateEngineDiagnostics method should pass the engine diagnostics to the bluetooth controller")
+    {
+        const EngineDiagnostics diagnostics;
+        PeripheralsController peripheralsController(mockBluetoothController.get(), mockSdCardService.get(), mockEEPROMService.get());
+        Fake(Method(mockBluetoothController, updateEngineDiagnostics));
+
+        peripheralsController.updateEngineDiagnostics(diagnostics);
+
+        Verify(Method(mockBluetoothController, updateEngineDiagnostics)).Once();
+    }
+
     SECTION("isAnyDeviceConnected method should return bluetooth connection status")
     {
         PeripheralsController peripheralsController(mockBluetoothController.get(), mockSdCardService.get(), mockEEPROMService.get());
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <array>
+
 #include "catch2/catch_test_macros.hpp"
 #include "fakeit.hpp"
 
@@ -121,5 +124,41 @@ TEST_CASE("PowerManagerService", "[utils]")
 
             REQUIRE(batteryLevel == expectedBatteryLevel);
         }
+
+        SECTION("return the median of the samples")
+        {
+            static_assert(Configurations::batteryLevelArrayLength == 5, "The samples below assume five battery level samples per measurement");
+
+            mockArduino.Reset();
+            When(Method(mockArduino, analogReadMilliVolts)).Return(3'930, 3'370, 3'650, 3'510, 3'790);
+            Fake(Method(mockArduino, delay));
+
+            const auto batteryLevel = powerManager.measureBattery();
+
+            REQUIRE(batteryLevel == 50);
+        }
+    }
+
+    SECTION("medianBatteryLevel method should")
+    {
+        SECTION("return the middle sample for an odd sample count regardless of the order")
+        {
+            std::array<float, 5> batteryLevels{10, 30, 50, 70, 90};
+
+            do
+            {
+                REQUIRE(PowerManagerService::medianBatteryLevel(batteryLevels) == 50);
+            } while (std::next_permutation(begin(batteryLevels), end(batteryLevels)));
+        }
+
+        SECTION("return the mean of the two middle samples for an even sample count regardless of the order")
+        {
+            std::array<float, 6> batteryLevels{10, 30, 50, 70, 90, 100};
+
+            do
+            {
+                REQUIRE(PowerManagerService::medianBatteryLevel(batteryLevels) == 60);
+            } while (std::next_permutation(begin(batteryLevels), end(batteryLevels)));
+        }
     }
 }
\ No newline at end of file
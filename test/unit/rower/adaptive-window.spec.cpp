@@ -0,0 +1,74 @@
+// NOLINTBEGIN(readability-magic-numbers)
+#include "catch2/catch_test_macros.hpp"
+
+#include "../../../src/rower/adaptive-window.h"
+
+TEST_CASE("AdaptiveWindow")
+{
+    const auto processImpulse = [](AdaptiveWindow &window, const unsigned long processingTime, const unsigned long deltaTime)
+    {
+        window.startImpulse(1'000);
+        window.finishImpulse(1'000 + processingTime, deltaTime);
+    };
+
+    SECTION("should start with the maximum length")
+    {
+        const AdaptiveWindow window(5, 9);
+
+        REQUIRE(window.getLength() == 9);
+    }
+
+    SECTION("should shrink on every impulse that takes more than half of its delta time down to the minimum length")
+    {
+        AdaptiveWindow window(5, 9);
+
+        processImpulse(window, 3'000, 5'000);
+
+        REQUIRE(window.getLength() == 8);
+
+        for (auto i = 0U; i < 10; ++i)
+        {
+            processImpulse(window, 3'000, 5'000);
+        }
+
+        REQUIRE(window.getLength() == 5);
+    }
+
+    SECTION("should only grow after a window length of impulses in a row that used less than a quarter of their delta time")
+    {
+        AdaptiveWindow window(5, 9);
+        for (auto i = 0U; i < 4; ++i)
+        {
+            processImpulse(window, 3'000, 5'000);
+        }
+
+        for (auto i = 0U; i < 4; ++i)
+        {
+            processImpulse(window, 1'000, 10'000);
+        }
+        processImpulse(window, 3'000, 10'000);
+        for (auto i = 0U; i < 4; ++i)
+        {
+            processImpulse(window, 1'000, 10'000);
+        }
+
+        REQUIRE(window.getLength() == 5);
+
+        processImpulse(window, 1'000, 10'000);
+
+        REQUIRE(window.getLength() == 6);
+    }
+
+    SECTION("should not grow beyond the maximum length")
+    {
+        AdaptiveWindow window(5, 9);
+
+        for (auto i = 0U; i < 100; ++i)
+        {
+            processImpulse(window, 100, 10'000);
+        }
+
+        REQUIRE(window.getLength() == 9);
+    }
+}
+// NOLINTEND(readability-magic-numbers)
\ No newline at end of file
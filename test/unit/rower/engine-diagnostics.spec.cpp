@@ -0,0 +1,98 @@
+// NOLINTBEGIN(readability-magic-numbers)
+#include "catch2/catch_test_macros.hpp"
+
+#include "../../../src/rower/engine-diagnostics.h"
+#include "../../../src/utils/timing-histogram.h"
+
+TEST_CASE("TimingHistogram")
+{
+    SECTION("should put durations into log2 buckets")
+    {
+        STATIC_REQUIRE(TimingHistogram<8>::bucketIndex(0) == 0);
+        STATIC_REQUIRE(TimingHistogram<8>::bucketIndex(1) == 1);
+        STATIC_REQUIRE(TimingHistogram<8>::bucketIndex(2) == 2);
+        STATIC_REQUIRE(TimingHistogram<8>::bucketIndex(3) == 2);
+        STATIC_REQUIRE(TimingHistogram<8>::bucketIndex(4) == 3);
+        STATIC_REQUIRE(TimingHistogram<8>::bucketIndex(127) == 7);
+    }
+
+    SECTION("should collect durations beyond the range in the last bucket")
+    {
+        TimingHistogram<8> histogram;
+
+        histogram.record(128);
+        histogram.record(100'000);
+
+        CHECK(histogram.getBucket(7) == 2);
+        CHECK(histogram.getCount() == 2);
+        CHECK(histogram.getMaxTime() == 100'000);
+    }
+
+    SECTION("should count the recorded durations and track the longest")
+    {
+        TimingHistogram<8> histogram;
+
+        histogram.record(5);
+        histogram.record(6);
+        histogram.record(20);
+
+        CHECK(histogram.getBucket(3) == 2);
+        CHECK(histogram.getBucket(5) == 1);
+        CHECK(histogram.getBucket(8) == 0);
+        CHECK(histogram.getCount() == 3);
+        CHECK(histogram.getMaxTime() == 20);
+
+        histogram.reset();
+
+        CHECK(histogram.getBucket(3) == 0);
+        CHECK(histogram.getCount() == 0);
+        CHECK(histogram.getMaxTime() == 0);
+    }
+}
+
+TEST_CASE("EngineDiagnostics")
+{
+    SECTION("should record the time of each stage and the total processing time of the impulse")
+    {
+        EngineDiagnostics diagnostics;
+
+        diagnostics.startImpulse(1'000, 10'000);
+        diagnostics.finishStage(EngineStage::DeltaTimeRegression, 1'010);
+        diagnostics.finishStage(EngineStage::AngularRegression, 1'110);
+        diagnostics.finishImpulse(1'150);
+
+        CHECK(diagnostics.getHistogram(EngineStage::DeltaTimeRegression).getMaxTime() == 10);
+        CHECK(diagnostics.getHistogram(EngineStage::AngularRegression).getMaxTime() == 100);
+        CHECK(diagnostics.getHistogram(EngineStage::PhaseStateMachine).getMaxTime() == 40);
+        CHECK(diagnostics.getHistogram(EngineStage::Total).getMaxTime() == 150);
+        CHECK(diagnostics.getHistogram(EngineStage::Total).getCount() == 1);
+        CHECK(diagnostics.getLastProcessingTime() == 150);
+    }
+
+    SECTION("should attribute the time after the last finished stage to the phase state machine when a stage is skipped")
+    {
+        EngineDiagnostics diagnostics;
+
+        diagnostics.startImpulse(1'000, 10'000);
+        diagnostics.finishStage(EngineStage::DeltaTimeRegression, 1'010);
+        diagnostics.finishImpulse(1'015);
+
+        CHECK(diagnostics.getHistogram(EngineStage::AngularRegression).getCount() == 0);
+        CHECK(diagnostics.getHistogram(EngineStage::PhaseStateMachine).getMaxTime() == 5);
+        CHECK(diagnostics.getHistogram(EngineStage::Total).getMaxTime() == 15);
+    }
+
+    SECTION("should count an overrun when processing the previous impulse took longer than the current delta time")
+    {
+        EngineDiagnostics diagnostics;
+
+        diagnostics.startImpulse(0, 10'000);
+        diagnostics.finishImpulse(5'000);
+        diagnostics.startImpulse(10'000, 4'000);
+        diagnostics.finishImpulse(10'100);
+        diagnostics.startImpulse(14'000, 4'000);
+
+        CHECK(diagnostics.getOverrunCount() == 1);
+    }
+}
+// NOLINTEND(readability-magic-numbers)
\ No newline at end of file
@@ -27,6 +27,7 @@ TEST_CASE("FlywheelService", "[rower]")
 
     Fake(Method(mockGlobals, detachRotationInterrupt));
     Fake(Method(mockGlobals, attachRotationInterrupt));
+    When(Method(mockArduino, micros)).AlwaysReturn(50'000);
 
     SECTION("setup method should setup interrupts")
     {
@@ -60,14 +61,15 @@ TEST_CASE("FlywheelService", "[rower]")
             REQUIRE(flywheelService.hasDataChanged() == false);
         }
 
-        SECTION("should disable and then reenable interrupts when reading data")
+        SECTION("should not disable interrupts when reading data")
         {
             FlywheelService flywheelService;
 
+            flywheelService.processRotation(Configurations::rotationDebounceTimeMin + 1000);
             flywheelService.getData();
 
-            Verify(Method(mockGlobals, detachRotationInterrupt)).Once();
-            Verify(Method(mockGlobals, attachRotationInterrupt)).Once();
+            Verify(Method(mockGlobals, detachRotationInterrupt)).Exactly(0);
+            Verify(Method(mockGlobals, attachRotationInterrupt)).Exactly(0);
         }
 
         SECTION("should update data based on new valid measurement")
@@ -79,6 +81,7 @@ TEST_CASE("FlywheelService", "[rower]")
                 .totalAngularDisplacement = Configurations::angularDisplacementPerImpulse * (double)deltaTimes.size(),
                 .cleanImpulseTime = std::accumulate(cbegin(deltaTimes), cend(deltaTimes), 0UL),
                 .rawImpulseTime = std::accumulate(cbegin(deltaTimes), cend(deltaTimes), 0UL),
+                .queueTime = 50'000,
             };
 
             FlywheelService flywheelService;
@@ -91,7 +94,11 @@ TEST_CASE("FlywheelService", "[rower]")
                 flywheelService.processRotation(now);
             }
 
-            const auto result = flywheelService.getData();
+            auto result = flywheelService.getData();
+            while (flywheelService.hasDataChanged())
+            {
+                result = flywheelService.getData();
+            }
 
             REQUIRE(result.rawImpulseCount == expected.rawImpulseCount);
             REQUIRE(result.deltaTime == expected.deltaTime);
@@ -99,6 +106,58 @@ TEST_CASE("FlywheelService", "[rower]")
             REQUIRE(result.totalAngularDisplacement == expected.totalAngularDisplacement);
             REQUIRE(result.cleanImpulseTime == expected.cleanImpulseTime);
             REQUIRE(result.rawImpulseTime == expected.rawImpulseTime);
+            REQUIRE(result.queueTime == expected.queueTime);
+        }
+
+        SECTION("should return every queued impulse in order")
+        {
+            FlywheelService flywheelService;
+
+            auto now = 0UL;
+
+            for (const auto &testCase : deltaTimes)
+            {
+                now += testCase;
+                flywheelService.processRotation(now);
+            }
+
+            for (auto i = 0U; i < deltaTimes.size(); ++i)
+            {
+                REQUIRE(flywheelService.hasDataChanged());
+
+                const auto result = flywheelService.getData();
+
+                REQUIRE(result.rawImpulseCount == i + 1);
+                REQUIRE(result.deltaTime == deltaTimes[i]);
+                REQUIRE(result.totalTime == std::accumulate(cbegin(deltaTimes), cbegin(deltaTimes) + i + 1, 0UL));
+            }
+
+            REQUIRE(flywheelService.hasDataChanged() == false);
+        }
+
+        SECTION("should count the impulses dropped when the queue is full")
+        {
+            FlywheelService flywheelService;
+
+            const auto queuedImpulseCount = 100U;
+            auto now = 0UL;
+
+            for (auto i = 0U; i < queuedImpulseCount; ++i)
+            {
+                now += Configurations::rotationDebounceTimeMin + 1000;
+                flywheelService.processRotation(now);
+            }
+
+            auto result = flywheelService.getData();
+            auto readImpulseCount = 1U;
+            while (flywheelService.hasDataChanged())
+            {
+                result = flywheelService.getData();
+                ++readImpulseCount;
+            }
+
+            REQUIRE(result.droppedImpulseCount == queuedImpulseCount - readImpulseCount);
+            REQUIRE(result.rawImpulseCount == readImpulseCount);
         }
 
         SECTION("should reset data changed indicator after reading the new data")
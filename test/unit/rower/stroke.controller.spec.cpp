@@ -3,6 +3,8 @@
 #include "catch2/catch_test_macros.hpp"
 #include "fakeit.hpp"
 
+#include "../include/Arduino.h"
+
 #include "../../../src/rower/stroke.controller.h"
 
 using namespace fakeit;
@@ -16,6 +18,14 @@ const std::vector<unsigned long> deltaTimes = {
 
 TEST_CASE("StrokeController", "[rower]")
 {
+    mockArduino.Reset();
+
+    When(Method(mockArduino, micros)).AlwaysReturn(10'000);
+    Fake(Method(mockArduino, xTaskCreatePinnedToCore));
+    Fake(Method(mockArduino, vTaskDelete));
+    When(Method(mockArduino, ulTaskNotifyTake)).AlwaysReturn(0);
+    Fake(Method(mockArduino, vTaskNotifyGiveFromISR));
+
     SECTION("begin method should setup FlywheelService and StrokeService")
     {
         Mock<IStrokeService> mockStrokeService;
@@ -39,6 +49,110 @@ TEST_CASE("StrokeController", "[rower]")
 #endif
     }
 
+    SECTION("begin method should start the stroke task")
+    {
+        Mock<IStrokeService> mockStrokeService;
+        Mock<IFlywheelService> mockFlywheelService;
+        Mock<IEEPROMService> mockEEPROMService;
+
+        Fake(Method(mockFlywheelService, setup));
+#if ENABLE_RUNTIME_SETTINGS
+        Fake(Method(mockStrokeService, setup));
+
+        When(Method(mockEEPROMService, getMachineSettings)).Return(RowerProfile::MachineSettings{});
+#endif
+
+        const auto expectedStackSize = 8'192U;
+
+        StrokeController strokeController(mockStrokeService.get(), mockFlywheelService.get(), mockEEPROMService.get());
+        strokeController.begin();
+
+        SECTION("pinned to the core not used by the BLE stack with a priority above the main loop")
+        {
+            Verify(Method(mockArduino, xTaskCreatePinnedToCore).Using(Ne(nullptr), StrEq("strokeTask"), Eq(expectedStackSize), Eq(static_cast<void *>(&strokeController)), Eq(10U), Ne(nullptr), Eq(1))).Once();
+        }
+
+        SECTION("before the rotation interrupt is attached")
+        {
+            Verify(Method(mockArduino, xTaskCreatePinnedToCore), Method(mockFlywheelService, setup));
+        }
+
+        SECTION("that waits for a notification without a timeout and deletes itself when the wait returns empty")
+        {
+            Verify(Method(mockArduino, ulTaskNotifyTake).Using(pdTRUE, portMAX_DELAY)).Once();
+            Verify(Method(mockArduino, vTaskDelete).Using(nullptr)).Once();
+        }
+    }
+
+    SECTION("stroke task should process the queued impulses on every notification")
+    {
+        Mock<IStrokeService> mockStrokeService;
+        Mock<IFlywheelService> mockFlywheelService;
+        Mock<IEEPROMService> mockEEPROMService;
+
+        Fake(Method(mockFlywheelService, setup));
+#if ENABLE_RUNTIME_SETTINGS
+        Fake(Method(mockStrokeService, setup));
+
+        When(Method(mockEEPROMService, getMachineSettings)).Return(RowerProfile::MachineSettings{});
+#endif
+        When(Method(mockArduino, ulTaskNotifyTake)).Return(1, 2, 0);
+        When(Method(mockFlywheelService, hasDataChanged)).Return(true, false, true, true, false);
+        When(Method(mockFlywheelService, getData)).Return(RowingDataModels::FlywheelData{.rawImpulseCount = 1}, RowingDataModels::FlywheelData{.rawImpulseCount = 2}, RowingDataModels::FlywheelData{.rawImpulseCount = 3});
+        Fake(Method(mockStrokeService, processData));
+
+        StrokeController strokeController(mockStrokeService.get(), mockFlywheelService.get(), mockEEPROMService.get());
+        strokeController.begin();
+
+        Verify(Method(mockStrokeService, processData)).Exactly(3);
+        Verify(Method(mockStrokeService, getData)).Exactly(0);
+        Verify(Method(mockArduino, vTaskDelete).Using(nullptr)).Once();
+    }
+
+    SECTION("notifyImpulseFromISR method should not notify before the stroke task is started")
+    {
+        Mock<IStrokeService> mockStrokeService;
+        Mock<IFlywheelService> mockFlywheelService;
+        Mock<IEEPROMService> mockEEPROMService;
+
+        StrokeController strokeController(mockStrokeService.get(), mockFlywheelService.get(), mockEEPROMService.get());
+        strokeController.notifyImpulseFromISR();
+
+        Verify(Method(mockArduino, vTaskNotifyGiveFromISR)).Exactly(0);
+    }
+
+    SECTION("processImpulses method should track the worst case queue depth and impulse lag")
+    {
+        Mock<IStrokeService> mockStrokeService;
+        Mock<IFlywheelService> mockFlywheelService;
+        Mock<IEEPROMService> mockEEPROMService;
+        When(Method(mockArduino, micros)).Return(12'000, 13'000, 20'500);
+        When(Method(mockFlywheelService, hasDataChanged)).Return(true, true, false, true, false);
+        When(Method(mockFlywheelService, getData)).Return(RowingDataModels::FlywheelData{.rawImpulseCount = 1, .queueTime = 10'000}, RowingDataModels::FlywheelData{.rawImpulseCount = 2, .queueTime = 11'000}, RowingDataModels::FlywheelData{.rawImpulseCount = 3, .queueTime = 20'000});
+        Fake(Method(mockStrokeService, processData));
+
+        StrokeController strokeController(mockStrokeService.get(), mockFlywheelService.get(), mockEEPROMService.get());
+        strokeController.processImpulses();
+        strokeController.processImpulses();
+
+        REQUIRE(strokeController.getMaxQueueDepth() == 2);
+        REQUIRE(strokeController.getMaxImpulseLag() == 2'000);
+    }
+
+    SECTION("getAllData method should return the metrics published by StrokeService")
+    {
+        Mock<IStrokeService> mockStrokeService;
+        Mock<IFlywheelService> mockFlywheelService;
+        Mock<IEEPROMService> mockEEPROMService;
+        When(Method(mockStrokeService, getData)).AlwaysReturn(RowingDataModels::RowingMetrics{.strokeCount = 5, .driveHandleForces = {1.0F, 2.0F}});
+
+        StrokeController strokeController(mockStrokeService.get(), mockFlywheelService.get(), mockEEPROMService.get());
+
+        REQUIRE(strokeController.getAllData().strokeCount == 5);
+        REQUIRE(strokeController.getAllData().driveHandleForces.size() == 2);
+        REQUIRE(strokeController.getStrokeCount() == 5);
+    }
+
     SECTION("update method")
     {
         SECTION("should do nothing if data has not changed")
@@ -47,11 +161,13 @@ TEST_CASE("StrokeController", "[rower]")
             Mock<IFlywheelService> mockFlywheelService;
             Mock<IEEPROMService> mockEEPROMService;
             When(Method(mockFlywheelService, hasDataChanged)).Return(false);
+            Fake(Method(mockStrokeService, acquireData));
 
             StrokeController strokeController(mockStrokeService.get(), mockFlywheelService.get(), mockEEPROMService.get());
             strokeController.update();
 
             Verify(Method(mockFlywheelService, hasDataChanged)).Once();
+            Verify(Method(mockStrokeService, acquireData)).Once();
             VerifyNoOtherInvocations(mockFlywheelService);
             VerifyNoOtherInvocations(mockStrokeService);
         }
@@ -63,6 +179,7 @@ TEST_CASE("StrokeController", "[rower]")
             Mock<IEEPROMService> mockEEPROMService;
             When(Method(mockFlywheelService, hasDataChanged)).Return(true);
             When(Method(mockFlywheelService, getData)).Return({});
+            Fake(Method(mockStrokeService, acquireData));
 
             StrokeController strokeController(mockStrokeService.get(), mockFlywheelService.get(), mockEEPROMService.get());
             strokeController.update();
@@ -70,6 +187,7 @@ TEST_CASE("StrokeController", "[rower]")
             Verify(Method(mockFlywheelService, hasDataChanged)).Once();
             Verify(Method(mockFlywheelService, getData)).Once();
             Verify(Method(mockStrokeService, processData)).Exactly(0);
+            Verify(Method(mockStrokeService, acquireData)).Once();
             Verify(Method(mockStrokeService, getData)).Exactly(0);
             VerifyNoOtherInvocations(mockFlywheelService);
             VerifyNoOtherInvocations(mockStrokeService);
@@ -80,32 +198,38 @@ TEST_CASE("StrokeController", "[rower]")
             Mock<IStrokeService> mockStrokeService;
             Mock<IFlywheelService> mockFlywheelService;
             Mock<IEEPROMService> mockEEPROMService;
-            When(Method(mockFlywheelService, hasDataChanged)).Return(true);
-            When(Method(mockFlywheelService, getData)).Return({
-                .rawImpulseCount = 1,
-            });
+            When(Method(mockFlywheelService, hasDataChanged)).Return(true, true, false);
+            When(Method(mockFlywheelService, getData)).Return(RowingDataModels::FlywheelData{.rawImpulseCount = 1}, RowingDataModels::FlywheelData{.rawImpulseCount = 2});
 
             Fake(Method(mockStrokeService, processData));
-            When(Method(mockStrokeService, getData)).Return({});
+            Fake(Method(mockStrokeService, acquireData));
 
             StrokeController strokeController(mockStrokeService.get(), mockFlywheelService.get(), mockEEPROMService.get());
             strokeController.update();
 
-            Verify(Method(mockFlywheelService, hasDataChanged)).Once();
+            SECTION("should drain every queued impulse")
+            {
+                Verify(Method(mockFlywheelService, hasDataChanged)).Exactly(3);
+                Verify(Method(mockFlywheelService, getData)).Exactly(2);
+            }
 
-            SECTION("should get flywheel data")
+            SECTION("should process new flywheel data in order")
             {
-                Verify(Method(mockFlywheelService, getData)).Once();
+                Verify(Method(mockStrokeService, processData).Matching([](const RowingDataModels::FlywheelData &data)
+                                                                       { return data.rawImpulseCount == 1; }),
+                       Method(mockStrokeService, processData).Matching([](const RowingDataModels::FlywheelData &data)
+                                                                       { return data.rawImpulseCount == 2; }));
             }
 
-            SECTION("should process new flywheel data")
+            SECTION("should acquire the metrics published after the impulses without copying them")
             {
-                Verify(Method(mockStrokeService, processData)).Once();
+                Verify(Method(mockStrokeService, processData) * 2 + Method(mockStrokeService, acquireData));
+                Verify(Method(mockStrokeService, getData)).Exactly(0);
             }
 
-            SECTION("should get new process metrics")
+            SECTION("should publish the flywheel data of the last impulse")
             {
-                Verify(Method(mockStrokeService, getData)).Once();
+                REQUIRE(strokeController.getRawImpulseCount() == 2);
             }
         }
     }
@@ -1,3 +1,4 @@
+#include <array>
 #include <fstream>
 #include <vector>
 
@@ -108,7 +109,13 @@ TEST_CASE("StrokeService")
 
     SECTION("processData method should correctly determine")
     {
-        StrokeService strokeService;
+        static std::array<unsigned int, 5> eventCounts{};
+        eventCounts.fill(0);
+        MetricsEventBus eventBus;
+        const auto subscriberId = eventBus.subscribe([](const RowingDataModels::MetricsEvent &event)
+                                                     { ++eventCounts[static_cast<unsigned char>(event.type)]; },
+                                                     {MetricsEventType::DriveStarted, MetricsEventType::StrokeCompleted, MetricsEventType::SessionStopped});
+        StrokeService strokeService(eventBus);
         const auto angularDisplacementPerImpulse = (2 * PI) / 3;
         auto rawImpulseCount = 0UL;
         auto totalTime = 0UL;
@@ -129,7 +136,9 @@ TEST_CASE("StrokeService")
             };
 
             strokeService.processData(data);
+            eventBus.dispatch(subscriberId);
             const auto prevStrokeCount = rowingMetrics.strokeCount;
+            strokeService.acquireData();
             rowingMetrics = strokeService.getData();
 
             if (rowingMetrics.strokeCount > prevStrokeCount)
@@ -138,12 +147,20 @@ TEST_CASE("StrokeService")
                 {
                     INFO("deltaTime: " << deltaTime << ", stroke number: " << rowingMetrics.strokeCount);
                     REQUIRE_THAT(rowingMetrics.driveHandleForces, Catch::Matchers::RangeEquals(forceCurves[rowingMetrics.strokeCount - 1], [](float first, float second)
-                                                                                               { return std::abs(first - second) < 0.00001F; }));
+                                                                                               { return std::abs(first - second) < 0.00001F * std::max(1.0F, std::abs(second)); }));
                     REQUIRE_THAT(rowingMetrics.dragCoefficient * 1e6, Catch::Matchers::WithinRel(dragFactors[rowingMetrics.strokeCount - 1], 0.0000001));
                 }
             }
         }
 
+        SECTION("emitted phase events")
+        {
+            REQUIRE(eventCounts[static_cast<unsigned char>(MetricsEventType::StrokeCompleted)] == rowingMetrics.strokeCount);
+            REQUIRE(eventCounts[static_cast<unsigned char>(MetricsEventType::DriveStarted)] == rowingMetrics.strokeCount);
+            REQUIRE(eventCounts[static_cast<unsigned char>(MetricsEventType::SessionStopped)] == 1);
+            REQUIRE(eventBus.getDroppedEventCount(subscriberId) == 0);
+        }
+
         SECTION("total rowing metrics")
         {
             REQUIRE(rowingMetrics.strokeCount == 10);
@@ -153,4 +170,115 @@ TEST_CASE("StrokeService")
             REQUIRE(rowingMetrics.lastRevTime == 39'577'207);
         }
     }
+    SECTION("processData method should publish the metrics of the impulse before emitting its phase event")
+    {
+        static StrokeService *eventStrokeService = nullptr;
+        static unsigned int strokeCompletedCount = 0;
+        static unsigned int staleEventCount = 0;
+        strokeCompletedCount = 0;
+        staleEventCount = 0;
+        MetricsEventBus eventBus;
+        const auto subscriberId = eventBus.subscribe([](const RowingDataModels::MetricsEvent & /*event*/)
+                                                     {
+                                                         ++strokeCompletedCount;
+                                                         eventStrokeService->acquireData();
+                                                         if (eventStrokeService->getData().strokeCount != strokeCompletedCount)
+                                                         {
+                                                             ++staleEventCount;
+                                                         }
+                                                     },
+                                                     {MetricsEventType::StrokeCompleted});
+        StrokeService strokeService(eventBus);
+        eventStrokeService = &strokeService;
+        const auto angularDisplacementPerImpulse = (2 * PI) / 3;
+        auto rawImpulseCount = 0UL;
+        auto totalTime = 0UL;
+        Configurations::precision totalAngularDisplacement = 0.0;
+        for (const auto &deltaTime : deltaTimes)
+        {
+            totalAngularDisplacement += angularDisplacementPerImpulse;
+            totalTime += deltaTime;
+            rawImpulseCount++;
+            strokeService.processData(RowingDataModels::FlywheelData{
+                .rawImpulseCount = rawImpulseCount,
+                .deltaTime = deltaTime,
+                .totalTime = totalTime,
+                .totalAngularDisplacement = totalAngularDisplacement,
+                .cleanImpulseTime = totalTime,
+                .rawImpulseTime = totalTime,
+            });
+            eventBus.dispatch(subscriberId);
+        }
+
+        REQUIRE(strokeCompletedCount == 10);
+        REQUIRE(staleEventCount == 0);
+    }
+
+    SECTION("processData method should only calculate the torque when the cycle phase needs it")
+    {
+        MetricsEventBus eventBus;
+        StrokeService strokeService(eventBus);
+        const auto angularDisplacementPerImpulse = (2 * PI) / 3;
+        auto rawImpulseCount = 0UL;
+        auto totalTime = 0UL;
+        Configurations::precision totalAngularDisplacement = 0.0;
+        const auto processImpulse = [&](const unsigned long deltaTime)
+        {
+            totalAngularDisplacement += angularDisplacementPerImpulse;
+            totalTime += deltaTime;
+            rawImpulseCount++;
+            strokeService.processData(RowingDataModels::FlywheelData{
+                .rawImpulseCount = rawImpulseCount,
+                .deltaTime = deltaTime,
+                .totalTime = totalTime,
+                .totalAngularDisplacement = totalAngularDisplacement,
+                .cleanImpulseTime = totalTime,
+                .rawImpulseTime = totalTime,
+            });
+            strokeService.acquireData();
+        };
+
+        // Decelerating flywheel while stopped: a drive is not plausible, so neither the angular derivatives nor the torque are needed
+        for (auto i = 0U; i < 20; ++i)
+        {
+            processImpulse(20'000 + i * 200);
+        }
+
+        REQUIRE(strokeService.getSkippedTorqueCalculations(CyclePhase::Stopped) == 20);
+        REQUIRE(strokeService.getSkippedTorqueCalculations(CyclePhase::Recovery) == 0);
+        REQUIRE(strokeService.getSkippedTorqueCalculations(CyclePhase::Drive) == 0);
+
+        // Accelerating flywheel: once the delta time regression picks up the acceleration the torque is needed to detect the drive, and then for the force curve on every drive impulse
+        for (auto i = 0U; i < 10; ++i)
+        {
+            processImpulse(24'000 - i * 300);
+        }
+        const auto skippedWhileStopped = strokeService.getSkippedTorqueCalculations(CyclePhase::Stopped);
+        for (auto i = 10U; i < 40; ++i)
+        {
+            processImpulse(24'000 - i * 300);
+        }
+
+        REQUIRE(strokeService.getSkippedTorqueCalculations(CyclePhase::Stopped) == skippedWhileStopped);
+        REQUIRE(strokeService.getSkippedTorqueCalculations(CyclePhase::Drive) == 0);
+        REQUIRE(strokeService.getData().strokeCount == 0);
+
+        // Decelerating flywheel after the drive: every recovery impulse only checks the delta time slope for a new drive
+        auto recoveryImpulseCount = 0U;
+        for (auto i = 0U; i < 80; ++i)
+        {
+            const auto isInRecovery = strokeService.getData().strokeCount == 1;
+            processImpulse(12'000 + i * 300);
+            if (isInRecovery)
+            {
+                ++recoveryImpulseCount;
+            }
+        }
+
+        REQUIRE(strokeService.getData().strokeCount == 1);
+        REQUIRE(recoveryImpulseCount > 0);
+        REQUIRE(strokeService.getSkippedTorqueCalculations(CyclePhase::Recovery) == recoveryImpulseCount);
+        REQUIRE(strokeService.getSkippedTorqueCalculations(CyclePhase::Stopped) == skippedWhileStopped);
+        REQUIRE(strokeService.getSkippedTorqueCalculations(CyclePhase::Drive) == 0);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,88 @@
+// NOLINTBEGIN(readability-magic-numbers)
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../../src/utils/seqlock-snapshot.h"
+
+struct TestSnapshot
+{
+    unsigned int count;
+    std::vector<float> values;
+};
+
+TEST_CASE("SeqlockSnapshot")
+{
+    SECTION("should not expose the back buffer before publishing")
+    {
+        SeqlockSnapshot<TestSnapshot> snapshot;
+
+        snapshot.back().count = 1;
+
+        REQUIRE(snapshot.front().count == 0);
+        REQUIRE(snapshot.getSequence() == 0);
+    }
+
+    SECTION("should make the back buffer the front one on publish")
+    {
+        SeqlockSnapshot<TestSnapshot> snapshot;
+
+        snapshot.back().count = 1;
+        snapshot.publish();
+
+        REQUIRE(snapshot.front().count == 1);
+        REQUIRE(snapshot.read().count == 1);
+        REQUIRE(snapshot.getSequence() == 1);
+    }
+
+    SECTION("should keep the published buffer intact while the next one is prepared")
+    {
+        SeqlockSnapshot<TestSnapshot> snapshot;
+
+        snapshot.back().count = 1;
+        snapshot.publish();
+        const auto &published = snapshot.front();
+
+        snapshot.back().count = 2;
+
+        REQUIRE(published.count == 1);
+        REQUIRE(&snapshot.back() != &published);
+    }
+
+    SECTION("should alternate between the two buffers")
+    {
+        SeqlockSnapshot<TestSnapshot> snapshot;
+
+        const auto *const first = &snapshot.back();
+        snapshot.publish();
+        const auto *const second = &snapshot.back();
+        snapshot.publish();
+
+        REQUIRE(first != second);
+        REQUIRE(&snapshot.front() == second);
+        REQUIRE(&snapshot.back() == first);
+    }
+
+    SECTION("should run the initializer on both buffers")
+    {
+        SeqlockSnapshot<TestSnapshot> snapshot([](TestSnapshot &buffer)
+                                               { buffer.values.reserve(10); });
+
+        REQUIRE(snapshot.front().values.capacity() >= 10);
+        REQUIRE(snapshot.back().values.capacity() >= 10);
+    }
+
+    SECTION("should hand over a vector by swap without reallocating")
+    {
+        SeqlockSnapshot<TestSnapshot> snapshot;
+        std::vector<float> values{1, 2, 3};
+        const auto *const data = values.data();
+
+        snapshot.back().values.swap(values);
+        snapshot.publish();
+
+        REQUIRE(snapshot.front().values.data() == data);
+        REQUIRE(snapshot.front().values.size() == 3);
+    }
+}
+// NOLINTEND(readability-magic-numbers)
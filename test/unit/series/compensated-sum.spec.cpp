@@ -0,0 +1,45 @@
+// NOLINTBEGIN(readability-magic-numbers)
+#include "catch2/catch_test_macros.hpp"
+
+#include "../../../src/utils/series/compensated-sum.h"
+
+TEST_CASE("CompensatedSum")
+{
+    SECTION("should keep the small values that a naive sum loses against a large running sum")
+    {
+        CompensatedSum sum;
+        sum.add(1e16);
+        sum.add(1.0);
+        sum.add(1.0);
+        sum.subtract(1e16);
+
+        REQUIRE(sum.value() == 2.0);
+    }
+
+    SECTION("should return to 0 when every added value is subtracted")
+    {
+        CompensatedSum sum;
+        for (auto i = 0U; i < 1'000; ++i)
+        {
+            sum.add(0.1 * i);
+        }
+        for (auto i = 0U; i < 1'000; ++i)
+        {
+            sum.subtract(0.1 * i);
+        }
+
+        REQUIRE(sum.value() == 0.0);
+    }
+
+    SECTION("should be 0 after reset")
+    {
+        CompensatedSum sum;
+        sum.add(1e16);
+        sum.add(1.0);
+
+        sum.reset();
+
+        REQUIRE(sum.value() == 0.0);
+    }
+}
+// NOLINTEND(readability-magic-numbers)
@@ -0,0 +1,44 @@
+// NOLINTBEGIN(readability-magic-numbers)
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "../../../src/utils/series/fixed-point-ols-linear-series.h"
+#include "../../../src/utils/series/ols-linear-series.h"
+#include "./regression.test-cases.spec.h"
+
+TEST_CASE("Fixed Point Ordinary Least Square Linear Regression", "[regression]")
+{
+    FixedPointOLSLinearSeries olsFixedReg;
+    OLSLinearSeries olsReg;
+
+    for (const auto &testCase : testCases)
+    {
+        olsFixedReg.push(static_cast<long long>(testCase[0]), static_cast<long long>(testCase[1]));
+        olsReg.push(testCase[0], testCase[1]);
+    }
+
+    SECTION("should calculate the same slope as the floating point regression")
+    {
+        CHECK_THAT(olsFixedReg.slope(), Catch::Matchers::WithinRel(olsReg.slope(), 1e-9));
+    }
+
+    SECTION("should calculate the same goodness of fit as the floating point regression")
+    {
+        CHECK_THAT(olsFixedReg.goodnessOfFit(), Catch::Matchers::WithinRel(olsReg.goodnessOfFit(), 1e-9));
+    }
+
+    SECTION("should return the first Y for yAtSeriesBegin")
+    {
+        REQUIRE(olsFixedReg.yAtSeriesBegin() == static_cast<long long>((*cbegin(testCases))[1]));
+        REQUIRE(olsFixedReg.size() == testCases.size());
+    }
+
+    SECTION("should be empty after reset")
+    {
+        olsFixedReg.reset();
+
+        REQUIRE(olsFixedReg.size() == 0);
+        REQUIRE(olsFixedReg.slope() == 0);
+    }
+}
+// NOLINTEND(readability-magic-numbers)
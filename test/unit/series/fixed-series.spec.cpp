@@ -0,0 +1,108 @@
+// NOLINTBEGIN(readability-magic-numbers)
+#include "catch2/catch_test_macros.hpp"
+
+#include "../../../src/utils/series/fixed-series.h"
+
+TEST_CASE("FixedSeries")
+{
+    SECTION("should have capacity of the template length")
+    {
+        REQUIRE(FixedSeries<10>::capacity() == 10);
+    }
+
+    SECTION("should return 0 for average and median when empty")
+    {
+        FixedSeries<4> series;
+
+        REQUIRE(series.size() == 0);
+        REQUIRE(series.average() == 0);
+        REQUIRE(series.median() == 0);
+    }
+
+    SECTION("should calculate median of a partially filled series")
+    {
+        FixedSeries<5> series;
+        series.push(3);
+        series.push(1);
+        series.push(2);
+
+        REQUIRE(series.size() == 3);
+        REQUIRE(series.median() == 2);
+        REQUIRE(series.sum() == 6);
+    }
+
+    SECTION("when full should drop the oldest value and keep index 0 as the oldest value")
+    {
+        FixedSeries<4> series;
+
+        for (auto i = 1U; i <= 7; ++i)
+        {
+            series.push(i);
+        }
+
+        REQUIRE(series.size() == 4);
+        CHECK(series[0] == 4);
+        CHECK(series[1] == 5);
+        CHECK(series[2] == 6);
+        CHECK(series[3] == 7);
+        CHECK(series.sum() == 22);
+        CHECK(series.average() == 5.5);
+        CHECK(series.median() == 5.5);
+    }
+
+    SECTION("should return the window as one contiguous range from the oldest value")
+    {
+        FixedSeries<4> series;
+
+        for (auto i = 1U; i <= 6; ++i)
+        {
+            series.push(i);
+        }
+
+        const auto values = series.values();
+
+        REQUIRE(values.size() == 4);
+        CHECK(values[0] == 3);
+        CHECK(values[1] == 4);
+        CHECK(values[2] == 5);
+        CHECK(values[3] == 6);
+        CHECK(&values[0] == &series[0]);
+    }
+
+    SECTION("should subtract the offset from every value and from the sum when shifted")
+    {
+        FixedSeries<4, double> series;
+        for (auto i = 1; i <= 6; ++i)
+        {
+            series.push(i);
+        }
+
+        series.shift(3);
+        series.push(7);
+
+        const auto values = series.values();
+
+        REQUIRE(values.size() == 4);
+        CHECK(values[0] == 1);
+        CHECK(values[1] == 2);
+        CHECK(values[2] == 3);
+        CHECK(values[3] == 7);
+        CHECK(series.sum() == 13);
+    }
+
+    SECTION("should be empty after reset")
+    {
+        FixedSeries<4> series;
+        series.push(1);
+        series.push(2);
+
+        series.reset();
+
+        REQUIRE(series.size() == 0);
+        REQUIRE(series.sum() == 0);
+
+        series.push(3);
+        REQUIRE(series[0] == 3);
+    }
+}
+// NOLINTEND(readability-magic-numbers)
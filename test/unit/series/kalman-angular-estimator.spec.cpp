@@ -0,0 +1,100 @@
+// NOLINTBEGIN(readability-magic-numbers)
+#include <cmath>
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "../../../src/utils/series/kalman-angular-estimator.h"
+
+TEST_CASE("KalmanAngularEstimator")
+{
+    // Angular displacement with constant jerk: theta(t) = t^3 / 6 + 2t^2 + 30t
+    const auto theta = [](const double t)
+    { return t * t * t / 6 + 2 * t * t + 30 * t; };
+    const auto omega = [](const double t)
+    { return t * t / 2 + 4 * t + 30; };
+    const auto alpha = [](const double t)
+    { return t + 4; };
+
+    SECTION("should start from the origin at rest")
+    {
+        const KalmanAngularEstimator<6> estimator(1e8, 0.02);
+
+        REQUIRE(estimator.angularVelocity() == 0.0);
+        REQUIRE(estimator.angularAcceleration() == 0.0);
+        REQUIRE(estimator.confidence() == 1.0);
+    }
+
+    SECTION("should track a constant jerk motion at the newest point when the window has a single point")
+    {
+        KalmanAngularEstimator<1> estimator(1e-3, 1e-6);
+
+        auto t = 0.0;
+        for (auto i = 0U; i < 200; ++i)
+        {
+            t += 0.01;
+            estimator.push(t, theta(t));
+        }
+
+        CHECK_THAT(estimator.angularVelocity(), Catch::Matchers::WithinRel(omega(t), 0.0001));
+        CHECK_THAT(estimator.angularAcceleration(), Catch::Matchers::WithinRel(alpha(t), 0.001));
+    }
+
+    SECTION("should return the estimates at the oldest point of the window")
+    {
+        KalmanAngularEstimator<6> estimator(1e-3, 1e-6);
+
+        auto t = 0.0;
+        for (auto i = 0U; i < 200; ++i)
+        {
+            t += 0.01;
+            estimator.push(t, theta(t));
+        }
+
+        const auto oldestT = t - 5 * 0.01;
+        CHECK_THAT(estimator.angularVelocity(), Catch::Matchers::WithinRel(omega(oldestT), 0.0001));
+        CHECK_THAT(estimator.angularAcceleration(), Catch::Matchers::WithinRel(alpha(oldestT), 0.001));
+    }
+
+    SECTION("should lower the confidence for a measurement that does not fit the prediction")
+    {
+        KalmanAngularEstimator<6> estimator(1e2, 0.01);
+
+        auto t = 0.0;
+        for (auto i = 0U; i < 100; ++i)
+        {
+            t += 0.01;
+            estimator.push(t, 30 * t);
+        }
+
+        REQUIRE(estimator.confidence() > 0.9);
+
+        t += 0.01;
+        estimator.push(t, 30 * t + 0.5);
+
+        REQUIRE(estimator.confidence() < 0.01);
+    }
+
+    SECTION("reset method should clear the state and restart from the next point")
+    {
+        KalmanAngularEstimator<6> estimator(1e-3, 1e-6);
+
+        auto t = 0.0;
+        for (auto i = 0U; i < 50; ++i)
+        {
+            t += 0.01;
+            estimator.push(t, theta(t));
+        }
+        estimator.reset();
+
+        REQUIRE(estimator.angularVelocity() == 0.0);
+        REQUIRE(estimator.confidence() == 0.0);
+
+        estimator.push(t, theta(t));
+
+        REQUIRE(estimator.angularVelocity() == 0.0);
+        REQUIRE(estimator.angularAcceleration() == 0.0);
+        REQUIRE(estimator.confidence() == 1.0);
+    }
+}
+// NOLINTEND(readability-magic-numbers)
\ No newline at end of file
@@ -0,0 +1,84 @@
+// NOLINTBEGIN(readability-magic-numbers)
+#include <algorithm>
+#include <array>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../../../src/utils/series/median-network.h"
+
+namespace
+{
+    template <unsigned short size>
+    void checkAgainstSort(std::mt19937 &generator)
+    {
+        // Few distinct values so ties (the tricky case for a selection network) are common
+        std::uniform_int_distribution<int> distribution(0, 5);
+        for (auto i = 0U; i < 50; ++i)
+        {
+            std::array<double, size> values{};
+            for (auto &value : values)
+            {
+                value = distribution(generator);
+            }
+
+            auto sorted = values;
+            std::sort(sorted.begin(), sorted.end());
+            const auto expected = size % 2 != 0 ? sorted[size / 2] : (sorted[size / 2 - 1] + sorted[size / 2]) / 2;
+
+            auto compileTimeValues = values;
+            auto runTimeValues = values;
+            REQUIRE(MedianNetwork::select<size>(compileTimeValues.data()) == expected);
+            REQUIRE(MedianNetwork::select(span<double>(runTimeValues)) == expected);
+        }
+    }
+}
+
+TEST_CASE("MedianNetwork")
+{
+    SECTION("should select the median of every size up to the maximum network size")
+    {
+        std::mt19937 generator(7);
+
+        [&generator]<size_t... sizes>(std::index_sequence<sizes...>)
+        {
+            (checkAgainstSort<sizes + 1>(generator), ...);
+        }(std::make_index_sequence<MedianNetwork::maxNetworkSize>{});
+    }
+
+    SECTION("should only keep the comparators needed for the median")
+    {
+        REQUIRE(MedianNetwork::Network<1>::comparators.empty());
+        REQUIRE(MedianNetwork::Network<3>::comparators.size() == 3);
+        REQUIRE(MedianNetwork::Network<7>::comparators.size() < MedianNetwork::batcherComparatorCount(7));
+    }
+
+    SECTION("should fall back to nth_element above the maximum network size")
+    {
+        std::vector<double> values(101);
+        for (auto i = 0U; i < values.size(); ++i)
+        {
+            values[i] = (i * 37) % values.size();
+        }
+
+        REQUIRE(MedianNetwork::select(span<double>(values)) == 50.0);
+
+        std::array<double, 100> evenValues{};
+        for (auto i = 0U; i < evenValues.size(); ++i)
+        {
+            evenValues[i] = (i * 37) % evenValues.size();
+        }
+
+        REQUIRE(MedianNetwork::select<100>(evenValues.data()) == 49.5);
+    }
+
+    SECTION("should return zero for an empty set")
+    {
+        std::array<double, 1> values{};
+
+        REQUIRE(MedianNetwork::select(span<double>(values.data(), 0)) == 0.0);
+    }
+}
+// NOLINTEND(readability-magic-numbers)
\ No newline at end of file
@@ -24,4 +24,53 @@ TEST_CASE("Ordinary Least Square Linear Regression", "[regression]")
         const auto goodnessOfFitExpected = 0.9961418613;
         CHECK_THAT(olsReg.goodnessOfFit(), Catch::Matchers::WithinRel(goodnessOfFitExpected, 0.00001));
     }
+
+    SECTION("should return the oldest Y in the window for yAtSeriesBegin")
+    {
+        const auto oldestTestCase = *(cend(testCases) - testMaxSize);
+        REQUIRE(olsReg.yAtSeriesBegin() == oldestTestCase[1]);
+        REQUIRE(olsReg.size() == testMaxSize);
+    }
+
+    SECTION("should return the same slope for a window as for an unbounded series of the same points")
+    {
+        OLSLinearSeries olsUnbounded;
+        for (auto testCase = cend(testCases) - testMaxSize; testCase != cend(testCases); ++testCase)
+        {
+            olsUnbounded.push((*testCase)[0], (*testCase)[1]);
+        }
+
+        REQUIRE(olsUnbounded.yAtSeriesBegin() == olsReg.yAtSeriesBegin());
+        CHECK_THAT(olsUnbounded.slope(), Catch::Matchers::WithinRel(olsReg.slope(), 1e-9));
+        CHECK_THAT(olsUnbounded.goodnessOfFit(), Catch::Matchers::WithinRel(olsReg.goodnessOfFit(), 1e-9));
+    }
+
+    SECTION("should not depend on the origin of X")
+    {
+        // An hour of total time in microseconds would swamp the sum of the squared X if it was not taken relative to the window
+        const auto sessionTime = 3'600'000'000.0;
+        OLSLinearSeries olsLate(testMaxSize);
+        OLSLinearSeries olsUnboundedLate;
+        for (const auto &testCase : testCases)
+        {
+            olsLate.push(sessionTime + testCase[0], testCase[1]);
+        }
+        for (auto testCase = cend(testCases) - testMaxSize; testCase != cend(testCases); ++testCase)
+        {
+            olsUnboundedLate.push(sessionTime + (*testCase)[0], (*testCase)[1]);
+        }
+
+        CHECK_THAT(olsLate.slope(), Catch::Matchers::WithinRel(olsReg.slope(), 1e-9));
+        CHECK_THAT(olsLate.goodnessOfFit(), Catch::Matchers::WithinRel(olsReg.goodnessOfFit(), 1e-9));
+        CHECK_THAT(olsUnboundedLate.slope(), Catch::Matchers::WithinRel(olsReg.slope(), 1e-9));
+    }
+
+    SECTION("should be empty after reset")
+    {
+        olsReg.reset();
+
+        REQUIRE(olsReg.size() == 0);
+        REQUIRE(olsReg.slope() == 0);
+        REQUIRE(olsReg.goodnessOfFit() == 0);
+    }
 }
@@ -0,0 +1,169 @@
+// NOLINTBEGIN(readability-magic-numbers)
+#include <algorithm>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../../../src/utils/series/order-statistic-pool.h"
+
+using std::vector;
+
+TEST_CASE("OrderStatisticPool")
+{
+    SECTION("median should return 0 when empty")
+    {
+        OrderStatisticPool<double> pool;
+
+        REQUIRE(pool.size() == 0);
+        REQUIRE(pool.median() == 0);
+    }
+
+    SECTION("kth should return values in ascending order")
+    {
+        const vector<double> values{5.5, -1.0, 3.25, 3.25, 0.0, 12.0, -7.5};
+        OrderStatisticPool<double> pool(values.size());
+
+        for (const auto &value : values)
+        {
+            pool.insert(value);
+        }
+
+        auto sorted = values;
+        std::sort(begin(sorted), end(sorted));
+
+        REQUIRE(pool.size() == values.size());
+        for (auto i = 0U; i < sorted.size(); ++i)
+        {
+            CHECK(pool.kth(i) == sorted[i]);
+        }
+    }
+
+    SECTION("median should return the middle value for odd size")
+    {
+        OrderStatisticPool<double> pool;
+        pool.insert(3.0);
+        pool.insert(1.0);
+        pool.insert(2.0);
+
+        REQUIRE(pool.median() == 2.0);
+    }
+
+    SECTION("median should return the average of the two middle values for even size")
+    {
+        OrderStatisticPool<double> pool;
+        pool.insert(4.0);
+        pool.insert(1.0);
+        pool.insert(3.0);
+        pool.insert(2.0);
+
+        REQUIRE(pool.median() == 2.5);
+    }
+
+    SECTION("median should truncate the average of the two middle values for integer values")
+    {
+        OrderStatisticPool<long long> pool;
+        pool.insert(4);
+        pool.insert(1);
+        pool.insert(3);
+        pool.insert(2);
+
+        REQUIRE(pool.median() == 2);
+    }
+
+    SECTION("erase should remove only one instance of a duplicated value")
+    {
+        OrderStatisticPool<double> pool;
+        pool.insert(1.0);
+        pool.insert(2.0);
+        pool.insert(2.0);
+
+        REQUIRE(pool.erase(2.0));
+        REQUIRE(pool.size() == 2);
+        REQUIRE(pool.kth(1) == 2.0);
+    }
+
+    SECTION("erase should return false when value is not found")
+    {
+        OrderStatisticPool<double> pool;
+        pool.insert(1.0);
+
+        REQUIRE_FALSE(pool.erase(2.0));
+        REQUIRE(pool.size() == 1);
+    }
+
+    SECTION("should keep the correct median while values are inserted and erased across several blocks")
+    {
+        const auto maxSize = 455U;
+        OrderStatisticPool<double> pool(maxSize);
+        vector<double> window;
+
+        for (auto i = 0U; i < 3'000; ++i)
+        {
+            const auto value = static_cast<double>((i * 7'919U) % 211U) - 100.0;
+            if (window.size() == maxSize)
+            {
+                REQUIRE(pool.erase(window.front()));
+                window.erase(begin(window));
+            }
+            pool.insert(value);
+            window.push_back(value);
+
+            auto sorted = window;
+            std::sort(begin(sorted), end(sorted));
+            const auto mid = sorted.size() / 2;
+            const auto expectedMedian = sorted.size() % 2 != 0 ? sorted[mid] : (sorted[mid] + sorted[mid - 1]) / 2;
+
+            REQUIRE(pool.median() == expectedMedian);
+        }
+
+        for (const auto &value : window)
+        {
+            REQUIRE(pool.erase(value));
+        }
+        REQUIRE(pool.size() == 0);
+    }
+
+    SECTION("should keep every order statistic correct while values are erased from anywhere in the pool")
+    {
+        const auto maxSize = 300U;
+        OrderStatisticPool<double> pool(maxSize);
+        vector<double> values;
+
+        for (auto i = 0U; i < 4'000; ++i)
+        {
+            if (values.size() == maxSize || (i % 5 == 0 && !values.empty()))
+            {
+                // Erasing from a pseudo random position empties and merges blocks on both sides of the erased value
+                const auto position = (i * 2'654'435'761U) % values.size();
+                REQUIRE(pool.erase(values[position]));
+                values.erase(begin(values) + position);
+            }
+            const auto value = static_cast<double>((i * 104'729U) % 997U);
+            pool.insert(value);
+            values.push_back(value);
+        }
+
+        auto sorted = values;
+        std::sort(begin(sorted), end(sorted));
+
+        REQUIRE(pool.size() == sorted.size());
+        for (auto i = 0U; i < sorted.size(); ++i)
+        {
+            REQUIRE(pool.kth(i) == sorted[i]);
+        }
+        REQUIRE(pool.kth(sorted.size()) == 0);
+    }
+
+    SECTION("reset should clear all values")
+    {
+        OrderStatisticPool<double> pool;
+        pool.insert(1.0);
+        pool.insert(2.0);
+
+        pool.reset();
+
+        REQUIRE(pool.size() == 0);
+        REQUIRE(pool.median() == 0);
+    }
+}
+// NOLINTEND(readability-magic-numbers)
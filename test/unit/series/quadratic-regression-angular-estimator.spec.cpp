@@ -0,0 +1,174 @@
+// NOLINTBEGIN(readability-magic-numbers)
+#include <deque>
+#include <numbers>
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "../../../src/utils/series/quadratic-regression-angular-estimator.h"
+#include "../../../src/utils/series/ts-quadratic-series.h"
+
+TEST_CASE("QuadraticRegressionAngularEstimator")
+{
+    // Impulses of a flywheel with 6 magnets that is speeding up, with some jitter on the impulse times so the regressions do not fit exactly
+    const auto angularDisplacementPerImpulse = 2 * std::numbers::pi / 6;
+    const auto time = [](const unsigned int n)
+    { return 0.03 * n - 0.0001 * n * n + static_cast<double>((n * 7) % 5) * 1e-4; };
+
+    const auto windowLength = 6U;
+    typedef QuadraticRegressionAngularEstimator<TSQuadraticSeries<windowLength>, windowLength> Estimator;
+
+    // Reference that folds every regression into the weighted average of each point of its window when it is pushed, and reads the oldest point
+    struct EagerEstimator
+    {
+        struct Row
+        {
+            double velocity;
+            double acceleration;
+            double weight;
+        };
+
+        TSQuadraticSeries<windowLength> series;
+        std::deque<Row> rows;
+
+        EagerEstimator()
+        {
+            series.push(0, 0);
+        }
+
+        void push(const double pointX, const double pointY)
+        {
+            series.push(pointX, pointY);
+            rows.push_back({0, 0, 0});
+            if (rows.size() > windowLength)
+            {
+                rows.pop_front();
+            }
+            const auto goodnessOfFit = series.goodnessOfFit();
+            for (unsigned char i = 0; i < rows.size(); ++i)
+            {
+                rows[i].velocity += series.firstDerivativeAtPosition(i) * goodnessOfFit;
+                rows[i].acceleration += series.secondDerivativeAtPosition(i) * goodnessOfFit;
+                rows[i].weight += goodnessOfFit;
+            }
+        }
+
+        double angularVelocity() const
+        {
+            return rows.empty() || rows.front().velocity == 0 ? 0 : rows.front().velocity / rows.front().weight;
+        }
+
+        double angularAcceleration() const
+        {
+            return rows.empty() || rows.front().acceleration == 0 ? 0 : rows.front().acceleration / rows.front().weight;
+        }
+    };
+
+    SECTION("should return zero until there are at least three points")
+    {
+        Estimator estimator;
+
+        REQUIRE(estimator.angularVelocity() == 0.0);
+
+        estimator.push(time(1), angularDisplacementPerImpulse);
+
+        REQUIRE(estimator.angularVelocity() == 0.0);
+        REQUIRE(estimator.angularAcceleration() == 0.0);
+        REQUIRE(estimator.confidence() == 0.0);
+    }
+
+    SECTION("should read the weighted average of the regressions at the oldest point of the window")
+    {
+        Estimator estimator;
+        EagerEstimator eagerEstimator;
+
+        for (auto n = 1U; n <= 40; ++n)
+        {
+            estimator.push(time(n), n * angularDisplacementPerImpulse);
+            eagerEstimator.push(time(n), n * angularDisplacementPerImpulse);
+
+            REQUIRE_THAT(estimator.angularVelocity(), Catch::Matchers::WithinRel(eagerEstimator.angularVelocity(), 1e-9));
+            REQUIRE_THAT(estimator.angularAcceleration(), Catch::Matchers::WithinRel(eagerEstimator.angularAcceleration(), 1e-9));
+        }
+        REQUIRE(estimator.confidence() > 0.9);
+    }
+
+    SECTION("should give the same estimates when they are only read after a number of impulses")
+    {
+        Estimator estimator;
+        EagerEstimator eagerEstimator;
+
+        for (auto n = 1U; n <= 40; ++n)
+        {
+            estimator.push(time(n), n * angularDisplacementPerImpulse);
+            eagerEstimator.push(time(n), n * angularDisplacementPerImpulse);
+
+            if (n % 9 == 0)
+            {
+                REQUIRE_THAT(estimator.angularVelocity(), Catch::Matchers::WithinRel(eagerEstimator.angularVelocity(), 1e-9));
+                REQUIRE_THAT(estimator.angularAcceleration(), Catch::Matchers::WithinRel(eagerEstimator.angularAcceleration(), 1e-9));
+            }
+        }
+    }
+
+    SECTION("should stay close to the estimates of the full window when the window shrinks and grows back with the series full")
+    {
+        Estimator estimator;
+        QuadraticRegressionAngularEstimator<TSQuadraticSeries<windowLength>, windowLength, 4> adaptiveEstimator;
+
+        for (auto n = 1U; n <= 40; ++n)
+        {
+            // The length changes by one per impulse, like the adaptive window does
+            if (n == 15 || n == 22)
+            {
+                adaptiveEstimator.setWindowLength(5);
+            }
+            if (n == 16)
+            {
+                adaptiveEstimator.setWindowLength(4);
+            }
+            if (n == 23)
+            {
+                adaptiveEstimator.setWindowLength(windowLength);
+            }
+            estimator.push(time(n), n * angularDisplacementPerImpulse);
+            adaptiveEstimator.push(time(n), n * angularDisplacementPerImpulse);
+
+            // The acceleration of the jittered impulses differs by more than a tenth between neighbouring impulses even with the full window, so it is only expected to be in the same range
+            REQUIRE_THAT(adaptiveEstimator.angularVelocity(), Catch::Matchers::WithinRel(estimator.angularVelocity(), 0.01));
+            REQUIRE_THAT(adaptiveEstimator.angularAcceleration(), Catch::Matchers::WithinRel(estimator.angularAcceleration(), 0.25));
+            // Once a full window of points was pushed with the regrown window every row received the regressions of the full window again
+            if (n >= 23 + windowLength - 1)
+            {
+                REQUIRE_THAT(adaptiveEstimator.angularVelocity(), Catch::Matchers::WithinRel(estimator.angularVelocity(), 1e-9));
+                REQUIRE_THAT(adaptiveEstimator.angularAcceleration(), Catch::Matchers::WithinRel(estimator.angularAcceleration(), 1e-9));
+            }
+        }
+    }
+
+    SECTION("reset method should clear the window")
+    {
+        Estimator estimator;
+
+        for (auto n = 1U; n <= 20; ++n)
+        {
+            estimator.push(time(n), n * angularDisplacementPerImpulse);
+        }
+        estimator.reset();
+
+        REQUIRE(estimator.angularVelocity() == 0.0);
+        REQUIRE(estimator.angularAcceleration() == 0.0);
+
+        Estimator newEstimator;
+        newEstimator.reset();
+        for (auto n = 1U; n <= 20; ++n)
+        {
+            estimator.push(time(n), n * angularDisplacementPerImpulse);
+            newEstimator.push(time(n), n * angularDisplacementPerImpulse);
+        }
+
+        REQUIRE(estimator.angularVelocity() == newEstimator.angularVelocity());
+        REQUIRE(estimator.angularAcceleration() == newEstimator.angularAcceleration());
+    }
+}
+// NOLINTEND(readability-magic-numbers)
@@ -0,0 +1,127 @@
+// NOLINTBEGIN(readability-magic-numbers)
+#include <array>
+#include <numbers>
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "../../../src/utils/series/savitzky-golay-angular-estimator.h"
+
+TEST_CASE("SavitzkyGolayAngularEstimator")
+{
+    // Impulses of a flywheel with 6 magnets where the time of the impulse n is t(n) = 0.03n - 0.0001n^2 (i.e. a flywheel that is speeding up)
+    const auto angularDisplacementPerImpulse = 2 * std::numbers::pi / 6;
+    const auto time = [](const double n)
+    { return 0.03 * n - 0.0001 * n * n; };
+    const auto omega = [angularDisplacementPerImpulse](const double n)
+    { return angularDisplacementPerImpulse / (0.03 - 0.0002 * n); };
+    const auto alpha = [angularDisplacementPerImpulse](const double n)
+    {
+        const auto slope = 0.03 - 0.0002 * n;
+
+        return 2 * angularDisplacementPerImpulse * 0.0001 / (slope * slope * slope);
+    };
+
+    SECTION("should return zero until there are at least three points")
+    {
+        SavitzkyGolayAngularEstimator<6> estimator;
+
+        REQUIRE(estimator.angularVelocity() == 0.0);
+
+        estimator.push(time(1), angularDisplacementPerImpulse);
+
+        REQUIRE(estimator.angularVelocity() == 0.0);
+        REQUIRE(estimator.angularAcceleration() == 0.0);
+        REQUIRE(estimator.confidence() == 0.0);
+    }
+
+    SECTION("should return the exact derivatives of a quadratic time series at the oldest point of the window")
+    {
+        SavitzkyGolayAngularEstimator<6> estimator;
+
+        for (auto n = 1U; n <= 20; ++n)
+        {
+            estimator.push(time(n), n * angularDisplacementPerImpulse);
+        }
+
+        CHECK_THAT(estimator.angularVelocity(), Catch::Matchers::WithinRel(omega(15), 1e-9));
+        CHECK_THAT(estimator.angularAcceleration(), Catch::Matchers::WithinRel(alpha(15), 1e-6));
+        REQUIRE(estimator.confidence() == 1.0);
+    }
+
+    SECTION("should use the same fit while the window fills up")
+    {
+        SavitzkyGolayAngularEstimator<6> estimator;
+
+        for (auto n = 1U; n <= 3; ++n)
+        {
+            estimator.push(time(n), n * angularDisplacementPerImpulse);
+        }
+
+        CHECK_THAT(estimator.angularVelocity(), Catch::Matchers::WithinRel(omega(0), 1e-9));
+        CHECK_THAT(estimator.angularAcceleration(), Catch::Matchers::WithinRel(alpha(0), 1e-6));
+    }
+
+    SECTION("should take an outlier impulse out of the fit and lower the confidence")
+    {
+        SavitzkyGolayAngularEstimator<9> estimator;
+        const std::array<double, 9> jitter = {0.00002, -0.00001, 0.00001, -0.00002, 0.003, 0.00001, -0.00001, 0.00002, -0.00002};
+
+        for (auto n = 0U; n < 9; ++n)
+        {
+            estimator.push(time(n + 10) + jitter[n], (n + 10) * angularDisplacementPerImpulse);
+        }
+
+        CHECK_THAT(estimator.angularVelocity(), Catch::Matchers::WithinRel(omega(10), 0.01));
+        CHECK_THAT(estimator.angularAcceleration(), Catch::Matchers::WithinRel(alpha(10), 0.25));
+        REQUIRE(estimator.confidence() < 1.0);
+        REQUIRE(estimator.confidence() > 0.5);
+    }
+
+    SECTION("should keep the oldest point of the window when the window length is reduced")
+    {
+        SavitzkyGolayAngularEstimator<9, 5> estimator;
+
+        for (auto n = 1U; n <= 20; ++n)
+        {
+            estimator.push(time(n), n * angularDisplacementPerImpulse);
+        }
+        estimator.setWindowLength(5);
+        estimator.push(time(21), 21 * angularDisplacementPerImpulse);
+
+        REQUIRE(estimator.getWindowLength() == 5);
+        CHECK_THAT(estimator.angularVelocity(), Catch::Matchers::WithinRel(omega(13), 1e-9));
+        CHECK_THAT(estimator.angularAcceleration(), Catch::Matchers::WithinRel(alpha(13), 1e-6));
+    }
+
+    SECTION("should keep the window length between the minimum and the maximum")
+    {
+        SavitzkyGolayAngularEstimator<9, 5> estimator;
+
+        REQUIRE(estimator.getWindowLength() == 9);
+
+        estimator.setWindowLength(2);
+
+        REQUIRE(estimator.getWindowLength() == 5);
+
+        estimator.setWindowLength(20);
+
+        REQUIRE(estimator.getWindowLength() == 9);
+    }
+
+    SECTION("reset method should clear the window")
+    {
+        SavitzkyGolayAngularEstimator<6> estimator;
+
+        for (auto n = 1U; n <= 10; ++n)
+        {
+            estimator.push(time(n), n * angularDisplacementPerImpulse);
+        }
+        estimator.reset();
+
+        REQUIRE(estimator.angularVelocity() == 0.0);
+        REQUIRE(estimator.angularAcceleration() == 0.0);
+        REQUIRE(estimator.confidence() == 0.0);
+    }
+}
+// NOLINTEND(readability-magic-numbers)
\ No newline at end of file
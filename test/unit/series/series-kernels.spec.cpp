@@ -0,0 +1,56 @@
+// NOLINTBEGIN(readability-magic-numbers)
+#include <array>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../../../src/utils/series/series-kernels.h"
+
+TEST_CASE("SeriesKernels")
+{
+    const std::array<double, 5> seriesX{1, 2, 2, 4, 6};
+    const std::array<double, 5> seriesY{2, 5, 7, 3, 1};
+
+    SECTION("slopesToPoint should calculate the slopes to the point and return 0 for equal X coordinates")
+    {
+        std::array<double, 5> slopes{};
+
+        SeriesKernels::slopesToPoint<double, double>(seriesX, seriesY, 4, 9, slopes);
+
+        CHECK(slopes[0] == (9.0 - 2) / (4.0 - 1));
+        CHECK(slopes[1] == 2);
+        CHECK(slopes[2] == 1);
+        CHECK(slopes[3] == 0);
+        CHECK(slopes[4] == (9.0 - 1) / (4.0 - 6));
+    }
+
+    SECTION("slopesFromPoint should calculate the slopes from the point and return 0 for equal X coordinates")
+    {
+        std::array<double, 5> slopes{};
+
+        SeriesKernels::slopesFromPoint<double, double>(2, 1, seriesX, seriesY, slopes);
+
+        CHECK(slopes[0] == (2.0 - 1) / (1.0 - 2));
+        CHECK(slopes[1] == 0);
+        CHECK(slopes[2] == 0);
+        CHECK(slopes[3] == 1);
+        CHECK(slopes[4] == 0);
+    }
+
+    SECTION("coefficientsA should calculate the quadratic coefficient of the parabolas and return 0 for equal X coordinates")
+    {
+        std::array<double, 5> coefficients{};
+
+        // Points of y = 2x^2 - 3x + 1 except the ones with X equal to the first or last point
+        const std::array<double, 5> middleX{1, 2, 3, 4, 5};
+        const std::array<double, 5> middleY{0, 3, 10, 21, 36};
+
+        SeriesKernels::coefficientsA<double, double>(1, 0, middleX, middleY, 4, 21, coefficients);
+
+        CHECK(coefficients[0] == 0);
+        CHECK(coefficients[1] == 2);
+        CHECK(coefficients[2] == 2);
+        CHECK(coefficients[3] == 0);
+        CHECK(coefficients[4] == 2);
+    }
+}
+// NOLINTEND(readability-magic-numbers)
@@ -12,6 +12,25 @@ TEST_CASE("Series")
         Series series(maxSeriesLength);
         REQUIRE(series.capacity() == maxSeriesLength);
     }
+    SECTION("when maxSeriesLength is reached should drop the oldest value and keep index 0 as the oldest value")
+    {
+        const auto maxSeriesLength = 4;
+        Series series(maxSeriesLength);
+
+        for (auto i = 1U; i <= 7; ++i)
+        {
+            series.push(i);
+        }
+
+        REQUIRE(series.size() == maxSeriesLength);
+        REQUIRE(series.capacity() == maxSeriesLength);
+        CHECK(series[0] == 4);
+        CHECK(series[1] == 5);
+        CHECK(series[2] == 6);
+        CHECK(series[3] == 7);
+        CHECK(series.sum() == 22);
+        CHECK(series.median() == 5.5);
+    }
     SECTION("when maxSeriesLength is not provided")
     {
         const auto maxCapacity = 500U;
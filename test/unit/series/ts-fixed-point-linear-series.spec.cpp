@@ -0,0 +1,45 @@
+// NOLINTBEGIN(readability-magic-numbers)
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "../../../src/utils/series/ts-fixed-point-linear-series.h"
+#include "../../../src/utils/series/ts-linear-series.h"
+#include "./regression.test-cases.spec.h"
+
+TEST_CASE("Fixed Point Theil Sen Linear Regression", "[regression]")
+{
+    TSFixedPointLinearSeries<testMaxSize> tsFixedReg;
+    TSLinearSeries<testMaxSize> tsReg;
+
+    SECTION("should calculate the same median as the floating point regression")
+    {
+        for (const auto &testCase : testCases)
+        {
+            tsFixedReg.push(static_cast<long long>(testCase[0]), static_cast<long long>(testCase[1]));
+            tsReg.push(testCase[0], testCase[1]);
+
+            REQUIRE_THAT(tsFixedReg.median(), Catch::Matchers::WithinAbs(tsReg.median(), 1e-9));
+            REQUIRE(tsFixedReg.yAtSeriesBegin() == static_cast<long long>(tsReg.yAtSeriesBegin()));
+        }
+    }
+
+    SECTION("should saturate the slope of an extreme delta time instead of overflowing")
+    {
+        tsFixedReg.push(0, 0);
+        tsFixedReg.push(1, 4'000'000'000);
+
+        REQUIRE(tsFixedReg.median() > 0);
+    }
+
+    SECTION("should be empty after reset")
+    {
+        tsFixedReg.push(0, 10'000);
+        tsFixedReg.push(10'000, 9'000);
+
+        tsFixedReg.reset();
+
+        REQUIRE(tsFixedReg.size() == 0);
+        REQUIRE(tsFixedReg.median() == 0);
+    }
+}
+// NOLINTEND(readability-magic-numbers)
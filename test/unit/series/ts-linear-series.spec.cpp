@@ -1,4 +1,5 @@
 #include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
 
 #include "../../../src/utils/series/ts-linear-series.h"
 #include "./regression.test-cases.spec.h"
@@ -6,7 +7,7 @@
 TEST_CASE("Theil Sen Linear Regression", "[regression]")
 {
     const auto testMaxSize = 7U;
-    TSLinearSeries tsReg(testMaxSize);
+    TSLinearSeries<testMaxSize> tsReg;
 
     for (const auto &testCase : testCases)
     {
@@ -26,18 +27,58 @@ TEST_CASE("Theil Sen Linear Regression", "[regression]")
 
     SECTION("should calculate coefficientB correctly")
     {
-        TSLinearSeries tsRegCoeffB(testMaxSize);
+        TSLinearSeries<testMaxSize> tsRegCoeffB;
 
         for (const auto &testCase : testCases)
         {
             tsRegCoeffB.push(testCase[1] / 1e6, testCase[0] / 1e6);
-            REQUIRE(tsRegCoeffB.coefficientB() == testCase[3]);
+            REQUIRE_THAT(tsRegCoeffB.coefficientB(), Catch::Matchers::WithinRel(testCase[3], 1e-9));
         }
     }
 
+    SECTION("should calculate the median from slopes stored in float")
+    {
+        TSLinearSeries<testMaxSize, PrecisionPolicy<float, double>> tsRegMixed;
+
+        for (const auto &testCase : testCases)
+        {
+            tsRegMixed.push(testCase[1] / 1e6, testCase[0] / 1e6);
+        }
+
+        REQUIRE_THAT(tsRegMixed.median(), Catch::Matchers::WithinRel(tsReg.median(), 1e-6));
+    }
+
+    SECTION("should not depend on the origin of X")
+    {
+        // An hour into the session (the test points are in seconds), the coordinates are rebased to the window so the slopes are taken from small differences
+        const auto sessionTime = 3'600.0;
+        TSLinearSeries<testMaxSize> tsRegLate;
+
+        for (const auto &testCase : testCases)
+        {
+            tsRegLate.push(sessionTime + testCase[1] / 1e6, testCase[0] / 1e6);
+        }
+
+        REQUIRE_THAT(tsRegLate.median(), Catch::Matchers::WithinRel(tsReg.median(), 1e-9));
+        REQUIRE_THAT(tsRegLate.coefficientB(), Catch::Matchers::WithinRel(tsReg.coefficientB() - tsReg.median() * sessionTime, 1e-9));
+    }
+
     SECTION("should be empty after reset")
     {
         tsReg.reset();
         REQUIRE(tsReg.median() == 0);
     }
+
+    SECTION("should calculate the same median when refilled after reset")
+    {
+        const auto expectedMedian = tsReg.median();
+        tsReg.reset();
+
+        for (const auto &testCase : testCases)
+        {
+            tsReg.push(testCase[1] / 1e6, testCase[0] / 1e6);
+        }
+
+        REQUIRE(tsReg.median() == expectedMedian);
+    }
 }
\ No newline at end of file
@@ -1,12 +1,16 @@
 // NOLINTBEGIN(readability-magic-numbers)
+#include <array>
+#include <vector>
+
 #include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
 
 #include "../../../src/utils/series/ts-quadratic-series.h"
 #include "./regression.test-cases.spec.h"
 
 TEST_CASE("Theil Sen Quadratic Regression", "[regression]")
 {
-    TSQuadraticSeries tsQuad(testMaxSize);
+    TSQuadraticSeries<testMaxSize> tsQuad;
 
     for (const auto &testCase : testCases)
     {
@@ -15,13 +19,13 @@ TEST_CASE("Theil Sen Quadratic Regression", "[regression]")
 
     SECTION("firstDerivativeAtPosition should return correct values")
     {
-        CHECK(tsQuad.firstDerivativeAtPosition(0) == 51.21269541835392);
-        CHECK(tsQuad.firstDerivativeAtPosition(1) == 52.632672200105446);
-        CHECK(tsQuad.firstDerivativeAtPosition(2) == 54.01497821210333);
-        CHECK(tsQuad.firstDerivativeAtPosition(3) == 55.36640827543397);
-        CHECK(tsQuad.firstDerivativeAtPosition(4) == 56.68125896514397);
-        CHECK(tsQuad.firstDerivativeAtPosition(5) == 57.96579700741671);
-        CHECK(tsQuad.firstDerivativeAtPosition(6) == 59.2248456690337);
+        CHECK_THAT(tsQuad.firstDerivativeAtPosition(0), Catch::Matchers::WithinRel(51.21269541835392, 1e-9));
+        CHECK_THAT(tsQuad.firstDerivativeAtPosition(1), Catch::Matchers::WithinRel(52.632672200105446, 1e-9));
+        CHECK_THAT(tsQuad.firstDerivativeAtPosition(2), Catch::Matchers::WithinRel(54.01497821210333, 1e-9));
+        CHECK_THAT(tsQuad.firstDerivativeAtPosition(3), Catch::Matchers::WithinRel(55.36640827543397, 1e-9));
+        CHECK_THAT(tsQuad.firstDerivativeAtPosition(4), Catch::Matchers::WithinRel(56.68125896514397, 1e-9));
+        CHECK_THAT(tsQuad.firstDerivativeAtPosition(5), Catch::Matchers::WithinRel(57.96579700741671, 1e-9));
+        CHECK_THAT(tsQuad.firstDerivativeAtPosition(6), Catch::Matchers::WithinRel(59.2248456690337, 1e-9));
         CHECK(tsQuad.firstDerivativeAtPosition(7) == 0);
         CHECK(tsQuad.firstDerivativeAtPosition(8) == 0);
     }
@@ -29,25 +33,154 @@ TEST_CASE("Theil Sen Quadratic Regression", "[regression]")
     SECTION("secondDerivativeAtPosition should return correct values")
     {
         const auto secondDerExpected = 35.20632687257407;
-        CHECK(tsQuad.secondDerivativeAtPosition(0) == secondDerExpected);
-        CHECK(tsQuad.secondDerivativeAtPosition(1) == secondDerExpected);
-        CHECK(tsQuad.secondDerivativeAtPosition(2) == secondDerExpected);
-        CHECK(tsQuad.secondDerivativeAtPosition(3) == secondDerExpected);
-        CHECK(tsQuad.secondDerivativeAtPosition(4) == secondDerExpected);
-        CHECK(tsQuad.secondDerivativeAtPosition(5) == secondDerExpected);
-        CHECK(tsQuad.secondDerivativeAtPosition(6) == secondDerExpected);
+        CHECK_THAT(tsQuad.secondDerivativeAtPosition(0), Catch::Matchers::WithinRel(secondDerExpected, 1e-9));
+        CHECK_THAT(tsQuad.secondDerivativeAtPosition(1), Catch::Matchers::WithinRel(secondDerExpected, 1e-9));
+        CHECK_THAT(tsQuad.secondDerivativeAtPosition(2), Catch::Matchers::WithinRel(secondDerExpected, 1e-9));
+        CHECK_THAT(tsQuad.secondDerivativeAtPosition(3), Catch::Matchers::WithinRel(secondDerExpected, 1e-9));
+        CHECK_THAT(tsQuad.secondDerivativeAtPosition(4), Catch::Matchers::WithinRel(secondDerExpected, 1e-9));
+        CHECK_THAT(tsQuad.secondDerivativeAtPosition(5), Catch::Matchers::WithinRel(secondDerExpected, 1e-9));
+        CHECK_THAT(tsQuad.secondDerivativeAtPosition(6), Catch::Matchers::WithinRel(secondDerExpected, 1e-9));
         CHECK(tsQuad.secondDerivativeAtPosition(7) == 0);
         CHECK(tsQuad.secondDerivativeAtPosition(8) == 0);
     }
 
     SECTION("should calculate correct goodness of fit")
     {
-        TSQuadraticSeries tsQuadGoodness(testMaxSize);
+        TSQuadraticSeries<testMaxSize> tsQuadGoodness;
 
         for (const auto &testCase : testCases)
         {
             tsQuadGoodness.push(testCase[0] / 1e6, testCase[2]);
-            REQUIRE(tsQuadGoodness.goodnessOfFit() == testCase[4]);
+            REQUIRE_THAT(tsQuadGoodness.goodnessOfFit(), Catch::Matchers::WithinRel(testCase[4], 1e-9));
+        }
+    }
+
+    SECTION("should match a new series after reset")
+    {
+        TSQuadraticSeries<testMaxSize> tsQuadReset;
+
+        for (const auto &testCase : testCases)
+        {
+            tsQuadReset.push(testCase[0] / 1e6 + 100.0, testCase[2] + 10.0);
+        }
+        tsQuadReset.reset();
+
+        CHECK(tsQuadReset.firstDerivativeAtPosition(0) == 0);
+        CHECK(tsQuadReset.goodnessOfFit() == 0);
+
+        for (const auto &testCase : testCases)
+        {
+            tsQuadReset.push(testCase[0] / 1e6, testCase[2]);
+        }
+
+        CHECK(tsQuadReset.firstDerivativeAtPosition(0) == tsQuad.firstDerivativeAtPosition(0));
+        CHECK(tsQuadReset.secondDerivativeAtPosition(0) == tsQuad.secondDerivativeAtPosition(0));
+        CHECK(tsQuadReset.goodnessOfFit() == tsQuad.goodnessOfFit());
+    }
+
+    SECTION("should not depend on the origin of the coordinates")
+    {
+        // A long session (hours of total time and thousands of radians) must give the same derivatives as the start of the session, as the coordinates are rebased to the window
+        TSQuadraticSeries<testMaxSize> tsQuadLate;
+
+        for (const auto &testCase : testCases)
+        {
+            tsQuadLate.push(10'000.0 + testCase[0] / 1e6, 100'000.0 + testCase[2]);
+        }
+
+        CHECK_THAT(tsQuadLate.secondDerivativeAtPosition(0), Catch::Matchers::WithinRel(tsQuad.secondDerivativeAtPosition(0), 1e-6));
+        CHECK_THAT(tsQuadLate.firstDerivativeAtPosition(0), Catch::Matchers::WithinRel(tsQuad.firstDerivativeAtPosition(0), 1e-6));
+        CHECK_THAT(tsQuadLate.firstDerivativeAtPosition(6), Catch::Matchers::WithinRel(tsQuad.firstDerivativeAtPosition(6), 1e-6));
+        CHECK_THAT(tsQuadLate.goodnessOfFit(), Catch::Matchers::WithinRel(tsQuad.goodnessOfFit(), 1e-6));
+    }
+
+    SECTION("should keep the precision of the points when storing the coefficients in float")
+    {
+        // One hour into the session the total time is only kept to about a quarter millisecond in float (with float points the first derivative would be off by ~45%), the mixed policy keeps the points in double so only the rounding of the stored coefficients remains
+        const auto sessionTime = 3'600.0;
+        TSQuadraticSeries<testMaxSize> tsQuadLate;
+        TSQuadraticSeries<testMaxSize, PrecisionPolicy<float, double>> tsQuadMixed;
+
+        for (const auto &testCase : testCases)
+        {
+            tsQuadLate.push(sessionTime + testCase[0] / 1e6, testCase[2]);
+            tsQuadMixed.push(sessionTime + testCase[0] / 1e6, testCase[2]);
+        }
+
+        CHECK_THAT(tsQuadMixed.secondDerivativeAtPosition(0), Catch::Matchers::WithinRel(tsQuadLate.secondDerivativeAtPosition(0), 1e-6));
+        CHECK_THAT(tsQuadMixed.firstDerivativeAtPosition(0), Catch::Matchers::WithinRel(tsQuadLate.firstDerivativeAtPosition(0), 1e-4));
+        CHECK_THAT(tsQuadLate.goodnessOfFit(), Catch::Matchers::WithinRel(std::prev(testCases.end())->at(4), 1e-9));
+    }
+
+    SECTION("should fit the oldest points of the window when the window length is changed")
+    {
+        // A series with a shorter window has to give the same fit as a series of that length that is behind by the points outside of the window, also after the window grows back and takes in points that it has no triples for
+        const std::vector<std::array<double, 2>> points = [&]()
+        {
+            std::vector<std::array<double, 2>> values;
+            for (const auto &testCase : testCases)
+            {
+                values.push_back({testCase[0] / 1e6, testCase[2]});
+            }
+
+            return values;
+        }();
+        const std::array<unsigned char, 6> windowLengths = {7, 5, 4, 4, 6, 7};
+
+        TSQuadraticSeries<testMaxSize> tsQuadAdaptive;
+        TSQuadraticSeries<4> tsQuadFour;
+        TSQuadraticSeries<5> tsQuadFive;
+        TSQuadraticSeries<6> tsQuadSix;
+        TSQuadraticSeries<testMaxSize> tsQuadSeven;
+
+        const auto checkWindow = [&tsQuadAdaptive](const auto &expected, const unsigned char windowLength)
+        {
+            for (unsigned char i = 0; i < windowLength; ++i)
+            {
+                REQUIRE_THAT(tsQuadAdaptive.firstDerivativeAtPosition(i), Catch::Matchers::WithinRel(expected.firstDerivativeAtPosition(i), 1e-9));
+            }
+            REQUIRE_THAT(tsQuadAdaptive.secondDerivativeAtPosition(0), Catch::Matchers::WithinRel(expected.secondDerivativeAtPosition(0), 1e-9));
+            REQUIRE_THAT(tsQuadAdaptive.goodnessOfFit(), Catch::Matchers::WithinRel(expected.goodnessOfFit(), 1e-9));
+        };
+
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            const unsigned char windowLength = i < testMaxSize ? testMaxSize : windowLengths[(i - testMaxSize) % windowLengths.size()];
+            tsQuadAdaptive.setWindowLength(windowLength);
+            tsQuadAdaptive.push(points[i][0], points[i][1]);
+
+            const auto pushLagging = [&points, i](auto &series, const unsigned char lag)
+            {
+                if (i >= lag)
+                {
+                    series.push(points[i - lag][0], points[i - lag][1]);
+                }
+            };
+            pushLagging(tsQuadFour, testMaxSize - 4);
+            pushLagging(tsQuadFive, testMaxSize - 5);
+            pushLagging(tsQuadSix, testMaxSize - 6);
+            pushLagging(tsQuadSeven, 0);
+
+            if (i < testMaxSize - 1)
+            {
+                continue;
+            }
+
+            switch (windowLength)
+            {
+            case 4:
+                checkWindow(tsQuadFour, windowLength);
+                break;
+            case 5:
+                checkWindow(tsQuadFive, windowLength);
+                break;
+            case 6:
+                checkWindow(tsQuadSix, windowLength);
+                break;
+            default:
+                checkWindow(tsQuadSeven, windowLength);
+                break;
+            }
         }
     }
 }
@@ -0,0 +1,75 @@
+// NOLINTBEGIN(readability-magic-numbers)
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "../../../src/utils/series/ts-quadratic-series.h"
+#include "../../../src/utils/series/ts-sampled-quadratic-series.h"
+#include "./regression.test-cases.spec.h"
+
+TEST_CASE("Theil Sen Sampled Quadratic Regression", "[regression]")
+{
+    SECTION("should recover the parabola of noise free points")
+    {
+        const auto maxSize = 24U;
+        TSSampledQuadraticSeries<maxSize, 4> tsQuadSampled;
+
+        // y = 3x^2 - 2x + 5 over 40 unevenly spaced points, so the window slides and the rings wrap
+        auto x = 0.0;
+        for (auto i = 0U; i < 40; ++i)
+        {
+            x += 0.01 + 0.002 * (i % 5);
+            tsQuadSampled.push(x, 3 * x * x - 2 * x + 5);
+        }
+
+        CHECK_THAT(tsQuadSampled.secondDerivativeAtPosition(0), Catch::Matchers::WithinRel(6.0, 1e-9));
+        CHECK_THAT(tsQuadSampled.firstDerivativeAtPosition(maxSize - 1), Catch::Matchers::WithinRel(6 * x - 2, 1e-9));
+        CHECK_THAT(tsQuadSampled.goodnessOfFit(), Catch::Matchers::WithinRel(1.0, 1e-9));
+    }
+
+    SECTION("should ignore the outliers of the window")
+    {
+        const auto maxSize = 15U;
+        TSSampledQuadraticSeries<maxSize, 6> tsQuadSampled;
+
+        auto x = 0.0;
+        for (auto i = 0U; i < maxSize; ++i)
+        {
+            x += 0.02;
+            const auto outlier = i == 5 || i == 11 ? 1.0 : 0.0;
+            tsQuadSampled.push(x, 3 * x * x - 2 * x + 5 + outlier);
+        }
+
+        CHECK_THAT(tsQuadSampled.secondDerivativeAtPosition(0), Catch::Matchers::WithinRel(6.0, 1e-9));
+    }
+
+    SECTION("should be close to the exact regression")
+    {
+        TSQuadraticSeries<testMaxSize> tsQuad;
+        TSSampledQuadraticSeries<testMaxSize, testMaxSize> tsQuadSampled;
+
+        for (const auto &testCase : testCases)
+        {
+            tsQuad.push(testCase[0] / 1e6, testCase[2]);
+            tsQuadSampled.push(testCase[0] / 1e6, testCase[2]);
+        }
+
+        CHECK_THAT(tsQuadSampled.secondDerivativeAtPosition(0), Catch::Matchers::WithinRel(tsQuad.secondDerivativeAtPosition(0), 0.05));
+        CHECK_THAT(tsQuadSampled.firstDerivativeAtPosition(0), Catch::Matchers::WithinRel(tsQuad.firstDerivativeAtPosition(0), 0.01));
+        CHECK(tsQuadSampled.firstDerivativeAtPosition(testMaxSize) == 0);
+    }
+
+    SECTION("should use every triple of the window when the budget covers every pattern")
+    {
+        TSQuadraticSeries<testMaxSize> tsQuad;
+        TSSampledQuadraticSeries<testMaxSize, (testMaxSize - 1) * (testMaxSize - 2) / 2> tsQuadSampled;
+
+        for (const auto &testCase : testCases)
+        {
+            tsQuad.push(testCase[0] / 1e6, testCase[2]);
+            tsQuadSampled.push(testCase[0] / 1e6, testCase[2]);
+
+            REQUIRE(tsQuadSampled.secondDerivativeAtPosition(0) == tsQuad.secondDerivativeAtPosition(0));
+        }
+    }
+}
+// NOLINTEND(readability-magic-numbers)
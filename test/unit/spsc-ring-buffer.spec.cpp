@@ -0,0 +1,79 @@
+// NOLINTBEGIN(readability-magic-numbers)
+#include "catch2/catch_test_macros.hpp"
+
+#include "../../src/utils/spsc-ring-buffer.h"
+
+TEST_CASE("SpscRingBuffer")
+{
+    SECTION("should be empty initially")
+    {
+        SpscRingBuffer<unsigned long, 4> ring;
+        unsigned long value = 0;
+
+        REQUIRE(ring.isEmpty());
+        REQUIRE(ring.size() == 0);
+        REQUIRE(ring.pop(value) == false);
+    }
+
+    SECTION("should return the values in the order they were pushed")
+    {
+        SpscRingBuffer<unsigned long, 4> ring;
+        unsigned long value = 0;
+
+        ring.push(1);
+        ring.push(2);
+        ring.push(3);
+
+        REQUIRE(ring.size() == 3);
+        REQUIRE(ring.pop(value));
+        CHECK(value == 1);
+        REQUIRE(ring.pop(value));
+        CHECK(value == 2);
+        REQUIRE(ring.pop(value));
+        CHECK(value == 3);
+        REQUIRE(ring.isEmpty());
+    }
+
+    SECTION("should keep the order when the indices wrap around")
+    {
+        SpscRingBuffer<unsigned long, 4> ring;
+        unsigned long value = 0;
+
+        for (auto i = 0UL; i < 10; ++i)
+        {
+            ring.push(i);
+            ring.push(i + 100);
+            REQUIRE(ring.pop(value));
+            CHECK(value == i);
+            REQUIRE(ring.pop(value));
+            CHECK(value == i + 100);
+        }
+
+        REQUIRE(ring.isEmpty());
+        REQUIRE(ring.getOverflowCount() == 0);
+    }
+
+    SECTION("when full should drop and count the new values")
+    {
+        SpscRingBuffer<unsigned long, 4> ring;
+        unsigned long value = 0;
+
+        for (auto i = 0UL; i < 6; ++i)
+        {
+            ring.push(i);
+        }
+
+        REQUIRE(ring.size() == 4);
+        REQUIRE(ring.getOverflowCount() == 2);
+        REQUIRE(ring.push(6) == false);
+        REQUIRE(ring.getOverflowCount() == 3);
+
+        for (auto i = 0UL; i < 4; ++i)
+        {
+            REQUIRE(ring.pop(value));
+            CHECK(value == i);
+        }
+        REQUIRE(ring.push(7));
+    }
+}
+// NOLINTEND(readability-magic-numbers)
\ No newline at end of file
@@ -0,0 +1,87 @@
+// NOLINTBEGIN(readability-magic-numbers)
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../../src/utils/triple-buffer.h"
+
+struct TestBufferValue
+{
+    unsigned int count;
+    std::vector<float> values;
+};
+
+TEST_CASE("TripleBuffer")
+{
+    SECTION("should not expose the back buffer before publishing")
+    {
+        TripleBuffer<TestBufferValue> buffer;
+
+        buffer.back().count = 1;
+
+        REQUIRE(buffer.acquire() == false);
+        REQUIRE(buffer.front().count == 0);
+    }
+
+    SECTION("should only expose a published buffer once it is acquired")
+    {
+        TripleBuffer<TestBufferValue> buffer;
+
+        buffer.back().count = 1;
+        buffer.publish();
+
+        REQUIRE(buffer.front().count == 0);
+        REQUIRE(buffer.acquire());
+        REQUIRE(buffer.front().count == 1);
+        REQUIRE(buffer.acquire() == false);
+        REQUIRE(buffer.front().count == 1);
+    }
+
+    SECTION("should acquire the last published buffer")
+    {
+        TripleBuffer<TestBufferValue> buffer;
+
+        for (auto i = 1U; i <= 5; ++i)
+        {
+            buffer.back().count = i;
+            buffer.publish();
+        }
+
+        REQUIRE(buffer.acquire());
+        REQUIRE(buffer.front().count == 5);
+    }
+
+    SECTION("should keep the acquired buffer intact however often the writer publishes")
+    {
+        TripleBuffer<TestBufferValue> buffer;
+
+        buffer.back().count = 1;
+        buffer.publish();
+        buffer.acquire();
+        const auto &front = buffer.front();
+
+        for (auto i = 2U; i <= 5; ++i)
+        {
+            REQUIRE(&buffer.back() != &front);
+            buffer.back().count = i;
+            buffer.publish();
+        }
+
+        REQUIRE(front.count == 1);
+        REQUIRE(&buffer.front() == &front);
+    }
+
+    SECTION("should run the initializer on every buffer")
+    {
+        TripleBuffer<TestBufferValue> buffer([](TestBufferValue &snapshot)
+                                          { snapshot.values.reserve(10); });
+
+        for (auto i = 0U; i < 3; ++i)
+        {
+            REQUIRE(buffer.back().values.capacity() >= 10);
+            buffer.publish();
+        }
+        REQUIRE(buffer.front().values.capacity() >= 10);
+    }
+}
+// NOLINTEND(readability-magic-numbers)